@@ -0,0 +1,72 @@
+// ---------------------------------------------------------------------------
+// Host test for AttractorField (src/attractor_field.h): the batched field
+// must give the same force as summing Attractor::attract() over its
+// attractors - same sqrt-table distance scale, radius cutoff, repulsors and
+// vortex tangents - at every point of the world.
+//
+// Usage: attractor_field_test    exit code 0 on pass, 1 on failure
+// ---------------------------------------------------------------------------
+#include <Arduino.h>
+
+#include <cmath>
+#include <cstdio>
+
+#include "attractor_field.h"
+
+static const int ATTRACTORS = 6;
+
+int main() {
+    Attractor attractors[ATTRACTORS];
+    attractors[0].setlocation(24, 24);
+    attractors[1].setlocation(10, 38);
+    attractors[1].setRepulsor(true);
+    attractors[1].setRadius(4, 20);
+    attractors[2].setlocation(40, 8);
+    attractors[2].setMass(120);
+    attractors[2].setVortex(true, 0.8f);
+    attractors[3].setlocation(-5, 30);
+    attractors[3].setG(0.6f);
+    attractors[3].setRadius(8, 60);
+    attractors[4].setlocation(31.3f, 33.7f);
+    attractors[4].setRepulsor(true);
+    attractors[4].setVortex(true, 0.3f);
+    attractors[4].setRadius(2, 12);
+    attractors[5].setlocation(12.5f, 12.5f);
+    attractors[5].setMass(1);
+
+    AttractorField field;
+    for (int k = 0; k < ATTRACTORS; k++) field.add(attractors[k]);
+
+    const float masses[] = {1.0f, 30.0f, 4.5f};
+    int points = 0, failures = 0;
+    float worst = 0;
+    for (float mass : masses) {
+        for (float y = -2; y <= 50; y += 0.25f) {
+            for (float x = -2; x <= 50; x += 0.25f) {
+                PVector exact(0, 0);
+                for (int k = 0; k < ATTRACTORS; k++) {
+                    const PVector f = attractors[k].attract(x, y, mass);
+                    exact.x += f.x;
+                    exact.y += f.y;
+                }
+                const PVector f = field.forceAt(x, y, mass);
+
+                const float err = hypotf(f.x - exact.x, f.y - exact.y);
+                const float scale = fmaxf(1.0f, hypotf(exact.x, exact.y));
+                worst = fmaxf(worst, err / scale);
+                if (err > 1e-5f * scale) {
+                    if (failures < 10) {
+                        printf("FAIL: mass %.1f at (%.2f, %.2f): field (%g, %g), attract() (%g, %g)\n",
+                               mass, x, y, f.x, f.y, exact.x, exact.y);
+                    }
+                    failures++;
+                }
+                points++;
+            }
+        }
+    }
+
+    printf("%d points, %d mismatches, worst relative error %g\n", points, failures, worst);
+    printf(failures ? "attractor_field_test: FAILED\n" : "attractor_field_test: ok\n");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,101 @@
+// ---------------------------------------------------------------------------
+// Host benchmark runner: registers the firmware's effects via src/main.cpp
+// setup(), then times every one with the shared EffectBench harness
+// (src/effect_bench.h) - the same rows the board prints for the 'B' / 'J'
+// serial commands.
+//
+// Usage: boids_bench [--frames N] [--warmup N] [--seed N] [--filter NAME]
+//                    [--csv FILE] [--json FILE]
+//   The suite runs once. Its CSV table always goes to stdout; --csv / --json
+//   also write the same results to a file for diffing across commits.
+// ---------------------------------------------------------------------------
+#include <Arduino.h>
+#include <FastLED.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "effect_bench.h"
+
+void setup();
+extern EffectContext context;
+extern EffectManager manager;
+
+// print()/println() onto a stdio stream, matching the Serial interface the
+// bench reports through.
+class FileOut {
+public:
+    explicit FileOut(FILE* f) : f(f) {}
+
+    void print(const char* s) { fputs(s, f); }
+    void print(int v) { fprintf(f, "%d", v); }
+    void print(unsigned int v) { fprintf(f, "%u", v); }
+    void print(unsigned long v) { fprintf(f, "%lu", v); }
+    void print(double v, int digits = 2) { fprintf(f, "%.*f", digits, v); }
+    void println() { fputc('\n', f); }
+    void println(const char* s) { print(s); println(); }
+    void println(double v, int digits) { print(v, digits); println(); }
+
+private:
+    FILE* f;
+};
+
+static uint32_t wallClock() { return (uint32_t)host::wallMicros(); }
+
+static bool writeReport(EffectBench& bench, const char* path, EffectBenchFormat format,
+                        const EffectBenchResult* results, uint8_t n) {
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "boids_bench: cannot write %s\n", path);
+        return false;
+    }
+    FileOut out(f);
+    bench.printReport(out, format, results, n);
+    fclose(f);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    EffectBench bench(context, wallClock, host::advanceMillis);
+    const char* filter = nullptr;
+    const char* csvPath = nullptr;
+    const char* jsonPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--frames") && hasValue) {
+            bench.frames = (uint16_t)strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--warmup") && hasValue) {
+            bench.warmup = (uint16_t)strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--seed") && hasValue) {
+            bench.seed = strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--filter") && hasValue) {
+            filter = argv[++i];
+        } else if (!strcmp(argv[i], "--csv") && hasValue) {
+            csvPath = argv[++i];
+        } else if (!strcmp(argv[i], "--json") && hasValue) {
+            jsonPath = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--frames N] [--warmup N] [--seed N] [--filter NAME] "
+                            "[--csv FILE] [--json FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    // Effects log through Serial; keep stdout to the report.
+    Serial.enabled = false;
+    host::useVirtualClock();
+    setup();
+
+    // One run; stdout and every file report the same numbers.
+    static EffectBenchResult results[EffectManager::MAX_EFFECTS];
+    const uint8_t n = bench.runAll(manager, results, EffectManager::MAX_EFFECTS, filter);
+
+    FileOut out(stdout);
+    bench.printReport(out, BENCH_CSV, results, n);
+
+    if (csvPath && !writeReport(bench, csvPath, BENCH_CSV, results, n)) return 1;
+    if (jsonPath && !writeReport(bench, jsonPath, BENCH_JSON, results, n)) return 1;
+    return 0;
+}
@@ -0,0 +1,43 @@
+# ---------------------------------------------------------------------------
+# Capture/compare round trip for boids_host --capture and frame_compare:
+#   - two captures with the same --seed must be pixel-identical
+#   - a logical-only capture of the same run (coded differently) must match
+#     the logical layer of the two-layer one
+#   - a capture with another seed must differ, so the seed reaches the run
+#
+# Usage: cmake -DBOIDS_HOST=... -DFRAME_COMPARE=... -DWORK_DIR=... [-DFRAMES=N]
+#              -P capture_compare_test.cmake
+# ---------------------------------------------------------------------------
+if(NOT FRAMES)
+  set(FRAMES 600)
+endif()
+file(MAKE_DIRECTORY ${WORK_DIR})
+
+function(capture name seed layers)
+  execute_process(
+    COMMAND ${BOIDS_HOST} ${FRAMES} --seed ${seed} --layers ${layers}
+            --capture ${WORK_DIR}/${name}.fs
+    RESULT_VARIABLE result OUTPUT_QUIET ERROR_QUIET)
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "boids_host capture ${name} failed (${result})")
+  endif()
+endfunction()
+
+function(compare golden candidate expected)
+  execute_process(
+    COMMAND ${FRAME_COMPARE} ${WORK_DIR}/${golden}.fs ${WORK_DIR}/${candidate}.fs
+    RESULT_VARIABLE result OUTPUT_VARIABLE output ERROR_VARIABLE output)
+  message(STATUS "${golden} vs ${candidate}: ${output}")
+  if(NOT result EQUAL expected)
+    message(FATAL_ERROR "frame_compare ${golden} ${candidate} exited ${result}, expected ${expected}")
+  endif()
+endfunction()
+
+capture(seed5_a 5 both)
+capture(seed5_b 5 both)
+capture(seed5_logical 5 logical)
+capture(seed6 6 both)
+
+compare(seed5_a seed5_b 0)
+compare(seed5_a seed5_logical 0)
+compare(seed5_a seed6 1)
@@ -0,0 +1,181 @@
+// ---------------------------------------------------------------------------
+// frame_compare: compare a captured frame stream against a golden one.
+//
+// Usage: frame_compare GOLDEN CANDIDATE [--layer logical|strip]
+//                      [--min-psnr DB] [--verbose]
+//
+// Reports per-frame PSNR and max channel delta for every frame that differs
+// (--verbose: every frame), then a summary. Exit status is 0 when every frame
+// is identical - or, with --min-psnr, when no frame falls below that PSNR -
+// and 1 otherwise, so it can gate scripted before/after runs.
+// ---------------------------------------------------------------------------
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "frame_stream.h"
+
+struct FrameDiff {
+    double psnr;       // INFINITY when identical
+    uint8_t maxDelta;
+    uint32_t changedPixels;
+};
+
+static FrameDiff diffPixels(const uint8_t* a, const uint8_t* b, size_t pixels) {
+    FrameDiff d = {INFINITY, 0, 0};
+    uint64_t squared = 0;
+    for (size_t p = 0; p < pixels; p++) {
+        bool changed = false;
+        for (int c = 0; c < 3; c++) {
+            int delta = abs((int)a[p * 3 + c] - (int)b[p * 3 + c]);
+            if (delta == 0) continue;
+            changed = true;
+            squared += (uint64_t)delta * delta;
+            if (delta > d.maxDelta) d.maxDelta = (uint8_t)delta;
+        }
+        if (changed) d.changedPixels++;
+    }
+    if (squared) {
+        double mse = (double)squared / (pixels * 3);
+        d.psnr = 10.0 * log10(255.0 * 255.0 / mse);
+    }
+    return d;
+}
+
+static FILE* openStream(const char* path, FrameStreamHeader& h) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "frame_compare: cannot open %s\n", path);
+        return nullptr;
+    }
+    if (!frameStreamReadHeader(f, h)) {
+        fprintf(stderr, "frame_compare: %s is not a frame stream (v%u)\n", path,
+                FRAME_STREAM_VERSION);
+        fclose(f);
+        return nullptr;
+    }
+    return f;
+}
+
+// Offset and size (in pixels) of the requested layer within a frame.
+static bool layerSpan(const FrameStreamHeader& h, uint8_t layer, size_t& offset, size_t& pixels) {
+    if (!(h.layers & layer)) return false;
+    offset = 0;
+    if (layer == FRAME_STREAM_STRIP && (h.layers & FRAME_STREAM_LOGICAL)) {
+        offset = (size_t)h.width * h.height * 3;
+    }
+    pixels = layer == FRAME_STREAM_LOGICAL ? (size_t)h.width * h.height : h.ledCount;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const char* paths[2] = {nullptr, nullptr};
+    int pathCount = 0;
+    uint8_t layer = 0;
+    double minPsnr = -1;
+    bool verbose = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--layer") && i + 1 < argc) {
+            const char* name = argv[++i];
+            layer = !strcmp(name, "strip") ? FRAME_STREAM_STRIP : FRAME_STREAM_LOGICAL;
+        } else if (!strcmp(argv[i], "--min-psnr") && i + 1 < argc) {
+            minPsnr = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--verbose")) {
+            verbose = true;
+        } else if (pathCount < 2) {
+            paths[pathCount++] = argv[i];
+        } else {
+            pathCount = 3;
+        }
+    }
+    if (pathCount != 2) {
+        fprintf(stderr, "usage: %s GOLDEN CANDIDATE [--layer logical|strip] [--min-psnr DB] "
+                        "[--verbose]\n", argv[0]);
+        return 2;
+    }
+
+    FrameStreamHeader hg, hc;
+    FILE* golden = openStream(paths[0], hg);
+    if (!golden) return 2;
+    FILE* candidate = openStream(paths[1], hc);
+    if (!candidate) return 2;
+
+    if (hg.width != hc.width || hg.height != hc.height || hg.ledCount != hc.ledCount) {
+        fprintf(stderr, "frame_compare: geometry differs (%ux%u/%u vs %ux%u/%u)\n", hg.width,
+                hg.height, hg.ledCount, hc.width, hc.height, hc.ledCount);
+        return 2;
+    }
+    if (hg.seed != hc.seed || hg.frameDtMs != hc.frameDtMs) {
+        fprintf(stderr, "frame_compare: warning: seed/dt differ (%u/%u ms vs %u/%u ms)\n",
+                hg.seed, hg.frameDtMs, hc.seed, hc.frameDtMs);
+    }
+
+    // Default to the logical image if both streams have it, else the strip.
+    if (!layer) {
+        layer = (hg.layers & hc.layers & FRAME_STREAM_LOGICAL) ? FRAME_STREAM_LOGICAL
+                                                                : FRAME_STREAM_STRIP;
+    }
+    size_t offG, offC, pixels, pixelsC;
+    if (!layerSpan(hg, layer, offG, pixels) || !layerSpan(hc, layer, offC, pixelsC)) {
+        fprintf(stderr, "frame_compare: %s layer missing from one of the streams\n",
+                layer == FRAME_STREAM_LOGICAL ? "logical" : "strip");
+        return 2;
+    }
+
+    // Frames are coded against their predecessor, so each buffer carries the
+    // previous frame into the next read.
+    std::vector<uint8_t> bufG(frameStreamPixelBytes(hg));
+    std::vector<uint8_t> bufC(frameStreamPixelBytes(hc));
+    std::vector<uint8_t> codedG(frameStreamMaxCodedBytes(bufG.size()));
+    std::vector<uint8_t> codedC(frameStreamMaxCodedBytes(bufC.size()));
+    FrameStreamFrameInfo infoG, infoC;
+
+    uint32_t frames = 0, differing = 0, belowMin = 0;
+    uint32_t worstFrame = 0;
+    double worstPsnr = INFINITY;
+    uint8_t maxDelta = 0;
+
+    while (frameStreamReadFrame(golden, infoG, bufG.data(), bufG.size(), codedG.data()) &&
+           frameStreamReadFrame(candidate, infoC, bufC.data(), bufC.size(), codedC.data())) {
+        FrameDiff d = diffPixels(&bufG[offG], &bufC[offC], pixels);
+        frames++;
+        if (d.maxDelta) differing++;
+        if (minPsnr >= 0 && d.psnr < minPsnr) belowMin++;
+        if (d.maxDelta > maxDelta) maxDelta = d.maxDelta;
+        if (d.psnr < worstPsnr) {
+            worstPsnr = d.psnr;
+            worstFrame = infoG.frame;
+        }
+        if (verbose || d.maxDelta) {
+            printf("frame %6u  t=%8u ms  psnr %7.2f dB  max delta %3u  changed px %4u%s\n",
+                   infoG.frame, infoG.millis, d.psnr, d.maxDelta, d.changedPixels,
+                   infoG.millis != infoC.millis ? "  (clock differs)" : "");
+        }
+    }
+
+    // The loop stops at the first failed read: if that was the golden stream,
+    // the candidate must be exhausted too for the lengths to match.
+    bool truncated = !feof(golden) || fgetc(candidate) != EOF;
+    if (truncated) {
+        printf("note: streams differ in length; compared the first %u frames\n", frames);
+    }
+
+    printf("%u frames compared (%s layer): %u identical, %u differ, max delta %u, ",
+           frames, layer == FRAME_STREAM_LOGICAL ? "logical" : "strip", frames - differing,
+           differing, maxDelta);
+    if (differing) {
+        printf("worst PSNR %.2f dB at frame %u\n", worstPsnr, worstFrame);
+    } else {
+        printf("pixel-identical\n");
+    }
+
+    fclose(golden);
+    fclose(candidate);
+
+    if (truncated) return 1;
+    if (minPsnr >= 0) return belowMin ? 1 : 0;
+    return differing ? 1 : 0;
+}
@@ -0,0 +1,149 @@
+// ---------------------------------------------------------------------------
+// Host-native runner: drives the unmodified src/main.cpp setup()/loop() on
+// Linux against the Arduino/FastLED shim in host/shim/.
+//
+// Usage: boids_host [frames] [--real-clock] [--seed N] [--effect NAME]
+//                   [--capture FILE] [--layers logical|strip|both] [--fps N]
+//   frames         number of loop() iterations to run (default 2000)
+//   --real-clock   use wall time instead of the virtual 60 Hz clock
+//   --seed N       seed for random()/random8() (default 1); setup() reseeds
+//                  random() from analogRead(0), which returns it too
+//   --effect NAME  start on the first registered effect whose name contains
+//                  NAME (rotation still follows suggestedDurationMs())
+//   --capture FILE write every presented frame to a frame stream (see
+//                  frame_stream.h); compare two with frame_compare
+//   --layers L     which buffers to capture (default both)
+//   --fps N        run the EffectManager's fixed-timestep scheduler at N
+//                  frames per second (default EFFECT_TARGET_FPS)
+// ---------------------------------------------------------------------------
+#include <Arduino.h>
+#include <FastLED.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "canvas.h"
+#include "effect_manager.h"
+#include "frame_stream.h"
+
+void setup();
+void loop();
+extern EffectManager manager;
+extern Canvas canvas;
+
+static const uint32_t FRAME_DT_MS = 16;
+
+static FILE* captureFile = nullptr;
+static uint8_t captureLayers = FRAME_STREAM_LOGICAL | FRAME_STREAM_STRIP;
+static uint32_t capturedFrames = 0;
+
+// One frame's pixel bytes, the previous frame's (the delta reference) and
+// the coded output, sized for both layers.
+static const size_t CAPTURE_MAX_BYTES = (size_t)COLS * ROWS * 3 + (size_t)NUM_LEDS * 3;
+static uint8_t captureFrameBytes[CAPTURE_MAX_BYTES];
+static uint8_t capturePrevBytes[CAPTURE_MAX_BYTES];
+static uint8_t captureCoded[frameStreamMaxCodedBytes(CAPTURE_MAX_BYTES)];
+
+static void captureFrame(const CRGB* leds, int count) {
+    size_t n = 0;
+    if (captureLayers & FRAME_STREAM_LOGICAL) {
+        for (uint8_t y = 0; y < ROWS; y++) {
+            for (uint8_t x = 0; x < COLS; x++) {
+                const CRGB& c = leds[matrixXY(x, y)];
+                captureFrameBytes[n++] = c.r;
+                captureFrameBytes[n++] = c.g;
+                captureFrameBytes[n++] = c.b;
+            }
+        }
+    }
+    if (captureLayers & FRAME_STREAM_STRIP) {
+        memcpy(captureFrameBytes + n, leds, (size_t)count * sizeof(CRGB));
+        n += (size_t)count * sizeof(CRGB);
+    }
+    frameStreamWriteFrame(captureFile, capturedFrames++, millis(), captureFrameBytes,
+                          capturePrevBytes, n, captureCoded);
+}
+
+int main(int argc, char** argv) {
+    long frames = 2000;
+    bool realClock = false;
+    unsigned long seed = 1;
+    const char* effectName = nullptr;
+    const char* capturePath = nullptr;
+    long fps = -1;
+
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--real-clock")) {
+            realClock = true;
+        } else if (!strcmp(argv[i], "--seed") && hasValue) {
+            seed = strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--effect") && hasValue) {
+            effectName = argv[++i];
+        } else if (!strcmp(argv[i], "--capture") && hasValue) {
+            capturePath = argv[++i];
+        } else if (!strcmp(argv[i], "--fps") && hasValue) {
+            fps = strtol(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--layers") && hasValue) {
+            const char* layers = argv[++i];
+            if (!strcmp(layers, "logical")) captureLayers = FRAME_STREAM_LOGICAL;
+            else if (!strcmp(layers, "strip")) captureLayers = FRAME_STREAM_STRIP;
+            else captureLayers = FRAME_STREAM_LOGICAL | FRAME_STREAM_STRIP;
+        } else {
+            frames = strtol(argv[i], nullptr, 10);
+        }
+    }
+
+    if (capturePath) {
+        if (realClock) {
+            fprintf(stderr, "boids_host: --capture needs the virtual clock\n");
+            return 2;
+        }
+        captureFile = fopen(capturePath, "wb");
+        if (!captureFile) {
+            fprintf(stderr, "boids_host: cannot write %s\n", capturePath);
+            return 1;
+        }
+        frameStreamWriteHeader(captureFile, COLS, ROWS, NUM_LEDS, captureLayers, (uint32_t)seed,
+                               FRAME_DT_MS);
+        FastLED.onShow = captureFrame;
+        Serial.enabled = false;
+    }
+
+    if (!realClock) host::useVirtualClock();
+    randomSeed(seed);
+    random16_set_seed((uint16_t)seed);
+    host::setAnalogValue((int)seed);
+
+    setup();
+    if (fps >= 0) manager.setTargetFps((uint16_t)fps);
+
+    if (effectName) {
+        for (uint8_t i = 0; i < manager.effectCount(); i++) {
+            if (strstr(manager.effectAt(i)->name(), effectName)) {
+                manager.setActive(i);
+                break;
+            }
+        }
+    }
+
+    uint64_t t0 = host::wallMicros();
+    for (long f = 0; f < frames; f++) {
+        loop();
+        if (!realClock) host::advanceMillis(FRAME_DT_MS);
+    }
+    canvas.finishShow();
+    uint64_t elapsed = host::wallMicros() - t0;
+
+    if (captureFile) {
+        const long bytes = ftell(captureFile);
+        fclose(captureFile);
+        fprintf(stderr, "[HOST] captured %u frames to %s (%ld bytes)\n", capturedFrames,
+                capturePath, bytes);
+    }
+
+    printf("[HOST] %ld frames, %u shown, %.1f us/frame\n", frames, FastLED.frameCount,
+           frames ? (double)elapsed / frames : 0.0);
+    return 0;
+}
@@ -0,0 +1,110 @@
+#ifndef HOST_SHIM_ARDUINO_H
+#define HOST_SHIM_ARDUINO_H
+
+// ---------------------------------------------------------------------------
+// Minimal Arduino core shim for the host-native (Linux) build.
+//
+// Only what src/ actually uses is provided: timing, random(), constrain/map,
+// PROGMEM accessors and a Serial stand-in that prints to stdout. The clock is
+// either real (wall time since start-up) or virtual (advanced explicitly by
+// the host harness) so benchmark and capture runs are deterministic.
+// ---------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <cmath>
+
+using std::abs;
+using std::max;
+using std::min;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define sq(x) ((x) * (x))
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_float(addr) (*(const float*)(addr))
+
+// --- Timing -------------------------------------------------------------------
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+inline void yield() {}
+
+// --- Random -------------------------------------------------------------------
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+// Returns the value set with host::setAnalogValue() (0 by default).
+int analogRead(uint8_t pin);
+
+// --- Serial -------------------------------------------------------------------
+class HostSerial {
+public:
+    void begin(unsigned long) {}
+    int available() { return 0; }
+    int read() { return -1; }
+
+    void print(const char* s);
+    void print(char c);
+    void print(int v);
+    void print(unsigned int v);
+    void print(long v);
+    void print(unsigned long v);
+    void print(double v, int digits = 2);
+
+    void println();
+    template <typename T> void println(T v) { print(v); println(); }
+    void println(double v, int digits) { print(v, digits); println(); }
+
+    // Set to false to silence [DEBUG] chatter during benchmark/capture runs.
+    bool enabled = true;
+};
+
+extern HostSerial Serial;
+
+// --- Host harness controls ----------------------------------------------------
+namespace host {
+
+// Switch millis()/micros() to a virtual clock starting at startMs. delay()
+// then advances the virtual clock instead of sleeping.
+void useVirtualClock(uint32_t startMs = 0);
+void useRealClock();
+bool virtualClock();
+void advanceMillis(uint32_t ms);
+void advanceMicros(uint32_t us);
+
+// Monotonic wall-clock in microseconds, independent of the virtual clock, for
+// measuring real execution time on the host.
+uint64_t wallMicros();
+
+// Value every analogRead() returns. setup() seeds random() from the floating
+// analogRead(0), so this is how a host run chooses its seed.
+void setAnalogValue(int value);
+
+} // namespace host
+
+#endif // HOST_SHIM_ARDUINO_H
@@ -0,0 +1,326 @@
+#ifndef HOST_SHIM_FASTLED_H
+#define HOST_SHIM_FASTLED_H
+
+// ---------------------------------------------------------------------------
+// Minimal FastLED shim for the host-native (Linux) build.
+//
+// Reproduces the subset of FastLED 3.6 that src/ uses: CRGB/CHSV, 8-bit math
+// (qadd8/qsub8/scale8/sin8/...), the FastLED random16 LCG, palettes and
+// ColorFromPalette, HeatColor, inoise8/inoise16, EVERY_N_* timers and a
+// headless controller whose show() just counts frames (and optionally hands
+// the strip buffer to a host hook). The integer math mirrors FastLED's C
+// fallbacks (FASTLED_SCALE8_FIXED == 1) so rendering matches the device
+// closely; inoise8/inoise16 are a plain Perlin implementation, not
+// bit-compatible with FastLED's.
+// ---------------------------------------------------------------------------
+
+#include "Arduino.h"
+
+#define FASTLED_SCALE8_FIXED 1
+#define FL_PROGMEM
+#define FASTLED_HOST_SHIM 1
+
+// --- 8-bit math -------------------------------------------------------------
+inline uint8_t qadd8(uint8_t i, uint8_t j) {
+    unsigned int t = i + j;
+    return t > 255 ? 255 : (uint8_t)t;
+}
+inline uint8_t qsub8(uint8_t i, uint8_t j) {
+    int t = i - j;
+    return t < 0 ? 0 : (uint8_t)t;
+}
+inline uint8_t scale8(uint8_t i, uint8_t scale) {
+    return (uint8_t)(((uint16_t)i * (1 + (uint16_t)scale)) >> 8);
+}
+inline uint8_t scale8_LEAVING_R1_DIRTY(uint8_t i, uint8_t scale) { return scale8(i, scale); }
+inline uint8_t scale8_video(uint8_t i, uint8_t scale) {
+    return (uint8_t)((((int)i * (int)scale) >> 8) + ((i && scale) ? 1 : 0));
+}
+inline uint16_t scale16(uint16_t i, uint16_t scale) {
+    return (uint16_t)(((uint32_t)i * (1 + (uint32_t)scale)) >> 16);
+}
+inline uint8_t sin8(uint8_t theta) {
+    static const uint8_t b_m16_interleave[] = {0, 49, 49, 41, 90, 27, 117, 10};
+    uint8_t offset = theta;
+    if (theta & 0x40) offset = (uint8_t)255 - offset;
+    offset &= 0x3F;
+    uint8_t secoffset = offset & 0x0F;
+    if (theta & 0x40) secoffset++;
+    uint8_t section = offset >> 4;
+    const uint8_t* p = b_m16_interleave + section * 2;
+    uint8_t b = p[0];
+    uint8_t m16 = p[1];
+    uint8_t mx = (m16 * secoffset) >> 4;
+    int8_t y = mx + b;
+    if (theta & 0x80) y = -y;
+    y += 128;
+    return (uint8_t)y;
+}
+inline uint8_t cos8(uint8_t theta) { return sin8(theta + 64); }
+inline int16_t sin16(uint16_t theta) {
+    static const uint16_t base[] = {0, 6393, 12539, 18204, 23170, 27245, 30273, 32137};
+    static const uint8_t slope[] = {49, 48, 44, 38, 31, 23, 14, 4};
+    uint16_t offset = (theta & 0x3FFF) >> 3;
+    if (theta & 0x4000) offset = 2047 - offset;
+    uint8_t section = offset / 256;
+    uint16_t b = base[section];
+    uint8_t m = slope[section];
+    uint8_t secoffset8 = (uint8_t)(offset) / 2;
+    uint16_t mx = m * secoffset8;
+    int16_t y = mx + b;
+    if (theta & 0x8000) y = -y;
+    return y;
+}
+inline int16_t cos16(uint16_t theta) { return sin16(theta + 16384); }
+
+// --- Random (FastLED's 16-bit LCG) --------------------------------------------
+extern uint16_t rand16seed;
+inline uint8_t random8() {
+    rand16seed = (rand16seed * 2053) + 13849;
+    return (uint8_t)(((uint8_t)(rand16seed & 0xFF)) + ((uint8_t)(rand16seed >> 8)));
+}
+inline uint8_t random8(uint8_t lim) { return (uint8_t)(((uint16_t)random8() * lim) >> 8); }
+inline uint8_t random8(uint8_t min, uint8_t lim) { return random8(lim - min) + min; }
+inline uint16_t random16() {
+    rand16seed = (rand16seed * 2053) + 13849;
+    return rand16seed;
+}
+inline uint16_t random16(uint16_t lim) { return (uint16_t)(((uint32_t)random16() * lim) >> 16); }
+inline uint16_t random16(uint16_t min, uint16_t lim) { return random16(lim - min) + min; }
+inline void random16_set_seed(uint16_t seed) { rand16seed = seed; }
+inline uint16_t random16_get_seed() { return rand16seed; }
+inline void random16_add_entropy(uint16_t entropy) { rand16seed += entropy; }
+
+// --- Beat generators ------------------------------------------------------------
+inline uint16_t beat16(uint16_t bpm, uint32_t timebase = 0) {
+    if (bpm < 256) bpm <<= 8;
+    return (uint16_t)(((millis() - timebase) * bpm * 280) >> 16);
+}
+inline uint8_t beat8(uint16_t bpm, uint32_t timebase = 0) { return beat16(bpm, timebase) >> 8; }
+inline uint8_t beatsin8(uint16_t bpm, uint8_t lowest = 0, uint8_t highest = 255,
+                        uint32_t timebase = 0, uint8_t phase_offset = 0) {
+    uint8_t beat = beat8(bpm, timebase);
+    uint8_t beatsin = sin8(beat + phase_offset);
+    uint8_t rangewidth = highest - lowest;
+    return lowest + scale8(beatsin, rangewidth);
+}
+
+// --- Colors ---------------------------------------------------------------------
+struct CHSV {
+    union {
+        struct { uint8_t hue, sat, val; };
+        struct { uint8_t h, s, v; };
+        uint8_t raw[3];
+    };
+    CHSV() : h(0), s(0), v(0) {}
+    CHSV(uint8_t ih, uint8_t is, uint8_t iv) : h(ih), s(is), v(iv) {}
+};
+
+struct CRGB;
+void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb);
+
+struct CRGB {
+    union {
+        struct { uint8_t r, g, b; };
+        struct { uint8_t red, green, blue; };
+        uint8_t raw[3];
+    };
+
+    typedef enum {
+        AliceBlue = 0xF0F8FF, Aqua = 0x00FFFF, Aquamarine = 0x7FFFD4, Black = 0x000000,
+        Blue = 0x0000FF, CadetBlue = 0x5F9EA0, CornflowerBlue = 0x6495ED, Cyan = 0x00FFFF,
+        DarkBlue = 0x00008B, DarkCyan = 0x008B8B, DarkGreen = 0x006400,
+        DarkOliveGreen = 0x556B2F, DarkRed = 0x8B0000, DeepPink = 0xFF1493,
+        DeepSkyBlue = 0x00BFFF, FireBrick = 0xB22222, ForestGreen = 0x228B22, Gold = 0xFFD700,
+        Goldenrod = 0xDAA520, Green = 0x008000, GreenYellow = 0xADFF2F, HotPink = 0xFF69B4,
+        Indigo = 0x4B0082, LawnGreen = 0x7CFC00, LightBlue = 0xADD8E6, LightGreen = 0x90EE90,
+        LightSkyBlue = 0x87CEFA, Lime = 0x00FF00, LimeGreen = 0x32CD32, Magenta = 0xFF00FF,
+        Maroon = 0x800000, MediumAquamarine = 0x66CDAA, MediumBlue = 0x0000CD,
+        MidnightBlue = 0x191970, Navy = 0x000080, OliveDrab = 0x6B8E23, Orange = 0xFFA500,
+        OrangeRed = 0xFF4500, Pink = 0xFFC0CB, Purple = 0x800080, Red = 0xFF0000,
+        SeaGreen = 0x2E8B57, SkyBlue = 0x87CEEB, Teal = 0x008080, Turquoise = 0x40E0D0,
+        Violet = 0xEE82EE, White = 0xFFFFFF, Yellow = 0xFFFF00, YellowGreen = 0x9ACD32
+    } HTMLColorCode;
+
+    CRGB() : r(0), g(0), b(0) {}
+    CRGB(uint8_t ir, uint8_t ig, uint8_t ib) : r(ir), g(ig), b(ib) {}
+    CRGB(uint32_t colorcode)
+        : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b(colorcode & 0xFF) {}
+    CRGB(HTMLColorCode colorcode) : CRGB((uint32_t)colorcode) {}
+    CRGB(const CHSV& rhs) { hsv2rgb_rainbow(rhs, *this); }
+
+    CRGB& operator=(const CHSV& rhs) {
+        hsv2rgb_rainbow(rhs, *this);
+        return *this;
+    }
+    CRGB& operator=(uint32_t colorcode) {
+        r = (colorcode >> 16) & 0xFF;
+        g = (colorcode >> 8) & 0xFF;
+        b = colorcode & 0xFF;
+        return *this;
+    }
+
+    uint8_t& operator[](uint8_t x) { return raw[x]; }
+    const uint8_t& operator[](uint8_t x) const { return raw[x]; }
+
+    CRGB& operator+=(const CRGB& rhs) {
+        r = qadd8(r, rhs.r);
+        g = qadd8(g, rhs.g);
+        b = qadd8(b, rhs.b);
+        return *this;
+    }
+    CRGB& operator-=(const CRGB& rhs) {
+        r = qsub8(r, rhs.r);
+        g = qsub8(g, rhs.g);
+        b = qsub8(b, rhs.b);
+        return *this;
+    }
+    CRGB& nscale8(uint8_t scaledown) {
+        r = scale8(r, scaledown);
+        g = scale8(g, scaledown);
+        b = scale8(b, scaledown);
+        return *this;
+    }
+    CRGB& fadeToBlackBy(uint8_t fadefactor) { return nscale8(255 - fadefactor); }
+
+    bool operator==(const CRGB& rhs) const { return r == rhs.r && g == rhs.g && b == rhs.b; }
+    bool operator!=(const CRGB& rhs) const { return !(*this == rhs); }
+};
+
+inline CRGB operator+(const CRGB& p1, const CRGB& p2) {
+    return CRGB(qadd8(p1.r, p2.r), qadd8(p1.g, p2.g), qadd8(p1.b, p2.b));
+}
+
+inline void fill_solid(CRGB* leds, int numToFill, const CRGB& color) {
+    for (int i = 0; i < numToFill; i++) leds[i] = color;
+}
+
+CRGB HeatColor(uint8_t temperature);
+
+// --- Palettes -------------------------------------------------------------------
+typedef uint32_t TProgmemRGBPalette16[16];
+typedef enum { NOBLEND = 0, LINEARBLEND = 1 } TBlendType;
+
+class CRGBPalette16 {
+public:
+    CRGB entries[16];
+
+    CRGBPalette16() {}
+    CRGBPalette16(const CRGB& c00, const CRGB& c01, const CRGB& c02, const CRGB& c03,
+                  const CRGB& c04, const CRGB& c05, const CRGB& c06, const CRGB& c07,
+                  const CRGB& c08, const CRGB& c09, const CRGB& c10, const CRGB& c11,
+                  const CRGB& c12, const CRGB& c13, const CRGB& c14, const CRGB& c15) {
+        const CRGB* c[16] = {&c00, &c01, &c02, &c03, &c04, &c05, &c06, &c07,
+                             &c08, &c09, &c10, &c11, &c12, &c13, &c14, &c15};
+        for (int i = 0; i < 16; i++) entries[i] = *c[i];
+    }
+    CRGBPalette16(const TProgmemRGBPalette16& rhs) {
+        for (int i = 0; i < 16; i++) entries[i] = CRGB(rhs[i]);
+    }
+
+    CRGB& operator[](uint8_t x) { return entries[x]; }
+    const CRGB& operator[](uint8_t x) const { return entries[x]; }
+};
+
+CRGB ColorFromPalette(const CRGBPalette16& pal, uint8_t index, uint8_t brightness = 255,
+                      TBlendType blendType = LINEARBLEND);
+CRGB ColorFromPalette(const TProgmemRGBPalette16& pal, uint8_t index, uint8_t brightness = 255,
+                      TBlendType blendType = LINEARBLEND);
+
+extern const TProgmemRGBPalette16 CloudColors_p;
+extern const TProgmemRGBPalette16 LavaColors_p;
+extern const TProgmemRGBPalette16 OceanColors_p;
+extern const TProgmemRGBPalette16 ForestColors_p;
+extern const TProgmemRGBPalette16 RainbowColors_p;
+extern const TProgmemRGBPalette16 RainbowStripeColors_p;
+extern const TProgmemRGBPalette16 PartyColors_p;
+
+// --- Noise ----------------------------------------------------------------------
+uint8_t inoise8(uint16_t x, uint16_t y, uint16_t z);
+uint8_t inoise8(uint16_t x, uint16_t y);
+uint8_t inoise8(uint16_t x);
+uint16_t inoise16(uint32_t x, uint32_t y, uint32_t z);
+uint16_t inoise16(uint32_t x, uint32_t y);
+uint16_t inoise16(uint32_t x);
+
+// --- Timers ---------------------------------------------------------------------
+class CEveryNMillis {
+public:
+    explicit CEveryNMillis(uint32_t period) : period(period), prevTrigger(millis()) {}
+    bool ready() {
+        uint32_t now = millis();
+        if (now - prevTrigger >= period) {
+            prevTrigger = now;
+            return true;
+        }
+        return false;
+    }
+    operator bool() { return ready(); }
+
+private:
+    uint32_t period;
+    uint32_t prevTrigger;
+};
+
+#define FASTLED_SHIM_CONCAT_(a, b) a##b
+#define FASTLED_SHIM_CONCAT(a, b) FASTLED_SHIM_CONCAT_(a, b)
+#define EVERY_N_MILLIS_I(NAME, N) static CEveryNMillis NAME(N); if (NAME)
+#define EVERY_N_MILLISECONDS(N) EVERY_N_MILLIS_I(FASTLED_SHIM_CONCAT(PER, __COUNTER__), N)
+#define EVERY_N_MILLIS(N) EVERY_N_MILLISECONDS(N)
+#define EVERY_N_SECONDS(N) EVERY_N_MILLIS_I(FASTLED_SHIM_CONCAT(PER, __COUNTER__), (N) * 1000UL)
+
+// --- Controller -----------------------------------------------------------------
+enum EOrder { RGB = 0012, RBG = 0021, GRB = 0102, GBR = 0120, BRG = 0201, BGR = 0210 };
+
+template <uint8_t DATA_PIN, EOrder RGB_ORDER> class WS2812B {};
+template <uint8_t DATA_PIN, EOrder RGB_ORDER> class WS2812 {};
+template <uint8_t DATA_PIN, EOrder RGB_ORDER> class NEOPIXEL {};
+
+class CLEDController {
+public:
+    CLEDController& setLeds(CRGB* data, int nLeds) {
+        leds_ = data;
+        count_ = nLeds;
+        return *this;
+    }
+    CRGB* leds() { return leds_; }
+    int size() const { return count_; }
+
+private:
+    CRGB* leds_ = nullptr;
+    int count_ = 0;
+};
+
+class CFastLED {
+public:
+    template <template <uint8_t DATA_PIN, EOrder RGB_ORDER> class CHIPSET, uint8_t DATA_PIN,
+              EOrder RGB_ORDER>
+    CLEDController& addLeds(CRGB* data, int nLeds) {
+        controller.setLeds(data, nLeds);
+        return controller;
+    }
+
+    void setBrightness(uint8_t scale) { brightness = scale; }
+    uint8_t getBrightness() const { return brightness; }
+
+    // Headless: count the frame and hand the strip to the host hook, if any.
+    void show();
+    uint16_t getFPS() const { return fps; }
+
+    CLEDController& operator[](int) { return controller; }
+
+    // Host hook invoked from show() with the strip buffer (e.g. frame capture).
+    void (*onShow)(const CRGB* leds, int count) = nullptr;
+    uint32_t frameCount = 0;
+
+private:
+    CLEDController controller;
+    uint8_t brightness = 255;
+    uint16_t fps = 0;
+    uint32_t fpsFrames = 0;
+    uint32_t fpsStartMs = 0;
+};
+
+extern CFastLED FastLED;
+
+#endif // HOST_SHIM_FASTLED_H
@@ -0,0 +1,334 @@
+// ---------------------------------------------------------------------------
+// Out-of-line parts of the host Arduino/FastLED shim: clock, random, Serial,
+// color conversion, palettes, noise and the headless controller.
+// ---------------------------------------------------------------------------
+#include "Arduino.h"
+#include "FastLED.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+// --- Clock ----------------------------------------------------------------------
+namespace {
+
+const std::chrono::steady_clock::time_point kStart = std::chrono::steady_clock::now();
+// Atomic: a SHOW_PIPELINE build reads the clock from the sender thread.
+std::atomic<bool> gVirtual{false};
+std::atomic<uint64_t> gVirtualUs{0};
+
+} // namespace
+
+namespace host {
+
+uint64_t wallMicros() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - kStart).count();
+}
+
+void useVirtualClock(uint32_t startMs) {
+    gVirtual = true;
+    gVirtualUs = (uint64_t)startMs * 1000;
+}
+
+void useRealClock() { gVirtual = false; }
+bool virtualClock() { return gVirtual; }
+void advanceMillis(uint32_t ms) { gVirtualUs += (uint64_t)ms * 1000; }
+void advanceMicros(uint32_t us) { gVirtualUs += us; }
+
+} // namespace host
+
+uint32_t micros() { return (uint32_t)(gVirtual ? gVirtualUs.load() : host::wallMicros()); }
+uint32_t millis() { return (uint32_t)((gVirtual ? gVirtualUs.load() : host::wallMicros()) / 1000); }
+
+void delay(uint32_t ms) {
+    if (gVirtual) {
+        host::advanceMillis(ms);
+    } else {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    }
+}
+
+void delayMicroseconds(uint32_t us) {
+    if (gVirtual) {
+        host::advanceMicros(us);
+    } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(us));
+    }
+}
+
+// --- Random ---------------------------------------------------------------------
+// xorshift32: deterministic across platforms, unlike libc rand().
+static uint32_t gRandomState = 0x2545F491u;
+
+void randomSeed(unsigned long seed) {
+    gRandomState = (uint32_t)seed ? (uint32_t)seed : 0x2545F491u;
+}
+
+static uint32_t nextRandom() {
+    uint32_t x = gRandomState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    gRandomState = x;
+    return x;
+}
+
+long random(long howbig) {
+    if (howbig <= 0) return 0;
+    return (long)(nextRandom() % (uint32_t)howbig);
+}
+
+long random(long howsmall, long howbig) {
+    if (howsmall >= howbig) return howsmall;
+    return random(howbig - howsmall) + howsmall;
+}
+
+uint16_t rand16seed = 1337;
+
+// --- Analog input ---------------------------------------------------------------
+static int gAnalogValue = 0;
+
+int analogRead(uint8_t) { return gAnalogValue; }
+
+void host::setAnalogValue(int value) { gAnalogValue = value; }
+
+// --- Serial ---------------------------------------------------------------------
+HostSerial Serial;
+
+void HostSerial::print(const char* s) { if (enabled) fputs(s, stdout); }
+void HostSerial::print(char c) { if (enabled) fputc(c, stdout); }
+void HostSerial::print(int v) { if (enabled) printf("%d", v); }
+void HostSerial::print(unsigned int v) { if (enabled) printf("%u", v); }
+void HostSerial::print(long v) { if (enabled) printf("%ld", v); }
+void HostSerial::print(unsigned long v) { if (enabled) printf("%lu", v); }
+void HostSerial::print(double v, int digits) { if (enabled) printf("%.*f", digits, v); }
+void HostSerial::println() { if (enabled) fputc('\n', stdout); }
+
+// --- Color conversion (FastLED hsv2rgb_rainbow) ------------------------------------
+void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb) {
+    uint8_t hue = hsv.hue;
+    uint8_t sat = hsv.sat;
+    uint8_t val = hsv.val;
+
+    uint8_t offset8 = (hue & 0x1F) << 3;
+    uint8_t third = scale8(offset8, (256 / 3));
+    uint8_t r, g, b;
+
+    if (!(hue & 0x80)) {
+        if (!(hue & 0x40)) {
+            if (!(hue & 0x20)) { r = 255 - third; g = third; b = 0; }
+            else               { r = 171; g = 85 + third; b = 0; }
+        } else {
+            if (!(hue & 0x20)) {
+                uint8_t twothirds = scale8(offset8, ((256 * 2) / 3));
+                r = 171 - twothirds; g = 170 + third; b = 0;
+            } else {
+                r = 0; g = 255 - third; b = third;
+            }
+        }
+    } else {
+        if (!(hue & 0x40)) {
+            if (!(hue & 0x20)) {
+                uint8_t twothirds = scale8(offset8, ((256 * 2) / 3));
+                r = 0; g = 171 - twothirds; b = 85 + twothirds;
+            } else {
+                r = third; g = 0; b = 255 - third;
+            }
+        } else {
+            if (!(hue & 0x20)) { r = 85 + third; g = 0; b = 171 - third; }
+            else               { r = 170 + third; g = 0; b = 85 - third; }
+        }
+    }
+
+    if (sat != 255) {
+        if (sat == 0) {
+            r = 255; g = 255; b = 255;
+        } else {
+            uint8_t desat = 255 - sat;
+            desat = scale8_video(desat, desat);
+            uint8_t satscale = 255 - desat;
+            r = scale8(r, satscale) + desat;
+            g = scale8(g, satscale) + desat;
+            b = scale8(b, satscale) + desat;
+        }
+    }
+
+    if (val != 255) {
+        val = scale8_video(val, val);
+        if (val == 0) {
+            r = 0; g = 0; b = 0;
+        } else {
+            r = scale8(r, val);
+            g = scale8(g, val);
+            b = scale8(b, val);
+        }
+    }
+
+    rgb.r = r;
+    rgb.g = g;
+    rgb.b = b;
+}
+
+CRGB HeatColor(uint8_t temperature) {
+    CRGB heatcolor;
+    uint8_t t192 = scale8_video(temperature, 191);
+    uint8_t heatramp = (t192 & 0x3F) << 2;
+    if (t192 & 0x80) {
+        heatcolor.r = 255; heatcolor.g = 255; heatcolor.b = heatramp;
+    } else if (t192 & 0x40) {
+        heatcolor.r = 255; heatcolor.g = heatramp; heatcolor.b = 0;
+    } else {
+        heatcolor.r = heatramp; heatcolor.g = 0; heatcolor.b = 0;
+    }
+    return heatcolor;
+}
+
+// --- Palettes -------------------------------------------------------------------
+const TProgmemRGBPalette16 CloudColors_p = {
+    CRGB::Blue, CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue,
+    CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue,
+    CRGB::Blue, CRGB::DarkBlue, CRGB::SkyBlue, CRGB::SkyBlue,
+    CRGB::LightBlue, CRGB::White, CRGB::LightBlue, CRGB::SkyBlue};
+const TProgmemRGBPalette16 LavaColors_p = {
+    CRGB::Black, CRGB::Maroon, CRGB::Black, CRGB::Maroon,
+    CRGB::DarkRed, CRGB::DarkRed, CRGB::Maroon, CRGB::DarkRed,
+    CRGB::DarkRed, CRGB::DarkRed, CRGB::Red, CRGB::Orange,
+    CRGB::White, CRGB::Orange, CRGB::Red, CRGB::DarkRed};
+const TProgmemRGBPalette16 OceanColors_p = {
+    CRGB::MidnightBlue, CRGB::DarkBlue, CRGB::MidnightBlue, CRGB::Navy,
+    CRGB::DarkBlue, CRGB::MediumBlue, CRGB::SeaGreen, CRGB::Teal,
+    CRGB::CadetBlue, CRGB::Blue, CRGB::DarkCyan, CRGB::CornflowerBlue,
+    CRGB::Aquamarine, CRGB::SeaGreen, CRGB::Aqua, CRGB::LightSkyBlue};
+const TProgmemRGBPalette16 ForestColors_p = {
+    CRGB::DarkGreen, CRGB::DarkGreen, CRGB::DarkOliveGreen, CRGB::DarkGreen,
+    CRGB::Green, CRGB::ForestGreen, CRGB::OliveDrab, CRGB::Green,
+    CRGB::SeaGreen, CRGB::MediumAquamarine, CRGB::LimeGreen, CRGB::YellowGreen,
+    CRGB::LightGreen, CRGB::LawnGreen, CRGB::MediumAquamarine, CRGB::ForestGreen};
+const TProgmemRGBPalette16 RainbowColors_p = {
+    0xFF0000, 0xD52A00, 0xAB5500, 0xAB7F00, 0xABAB00, 0x56D500, 0x00FF00, 0x00D52A,
+    0x00AB55, 0x0056AA, 0x0000FF, 0x2A00D5, 0x5500AB, 0x7F0081, 0xAB0055, 0xD5002B};
+const TProgmemRGBPalette16 RainbowStripeColors_p = {
+    0xFF0000, 0x000000, 0xAB5500, 0x000000, 0xABAB00, 0x000000, 0x00FF00, 0x000000,
+    0x00AB55, 0x000000, 0x0000FF, 0x000000, 0x5500AB, 0x000000, 0xAB0055, 0x000000};
+const TProgmemRGBPalette16 PartyColors_p = {
+    0x5500AB, 0x84007C, 0xB5004B, 0xE5001B, 0xE81700, 0xB84700, 0xAB7700, 0xABAB00,
+    0xAB5500, 0xDD2200, 0xF2000E, 0xC2003E, 0x8F0071, 0x5F00A1, 0x2F00D0, 0x0007F9};
+
+static CRGB paletteLookup(const CRGB& e1, const CRGB& e2, uint8_t lo4, uint8_t brightness,
+                          TBlendType blendType) {
+    uint8_t red1 = e1.r, green1 = e1.g, blue1 = e1.b;
+
+    if (lo4 && blendType != NOBLEND) {
+        uint8_t f2 = lo4 << 4;
+        uint8_t f1 = 255 - f2;
+        red1 = scale8(red1, f1) + scale8(e2.r, f2);
+        green1 = scale8(green1, f1) + scale8(e2.g, f2);
+        blue1 = scale8(blue1, f1) + scale8(e2.b, f2);
+    }
+
+    if (brightness != 255) {
+        if (brightness) {
+            ++brightness;
+            if (red1) red1 = scale8(red1, brightness);
+            if (green1) green1 = scale8(green1, brightness);
+            if (blue1) blue1 = scale8(blue1, brightness);
+        } else {
+            red1 = green1 = blue1 = 0;
+        }
+    }
+    return CRGB(red1, green1, blue1);
+}
+
+CRGB ColorFromPalette(const CRGBPalette16& pal, uint8_t index, uint8_t brightness,
+                      TBlendType blendType) {
+    uint8_t hi4 = index >> 4, lo4 = index & 0x0F;
+    return paletteLookup(pal[hi4], pal[(hi4 + 1) & 0x0F], lo4, brightness, blendType);
+}
+
+CRGB ColorFromPalette(const TProgmemRGBPalette16& pal, uint8_t index, uint8_t brightness,
+                      TBlendType blendType) {
+    uint8_t hi4 = index >> 4, lo4 = index & 0x0F;
+    return paletteLookup(CRGB(pal[hi4]), CRGB(pal[(hi4 + 1) & 0x0F]), lo4, brightness,
+                         blendType);
+}
+
+// --- Noise (classic Perlin, 8.8 lattice coordinates) ------------------------------
+static const uint8_t kPerm[256] = {
+    151, 160, 137, 91, 90, 15, 131, 13, 201, 95, 96, 53, 194, 233, 7, 225,
+    140, 36, 103, 30, 69, 142, 8, 99, 37, 240, 21, 10, 23, 190, 6, 148,
+    247, 120, 234, 75, 0, 26, 197, 62, 94, 252, 219, 203, 117, 35, 11, 32,
+    57, 177, 33, 88, 237, 149, 56, 87, 174, 20, 125, 136, 171, 168, 68, 175,
+    74, 165, 71, 134, 139, 48, 27, 166, 77, 146, 158, 231, 83, 111, 229, 122,
+    60, 211, 133, 230, 220, 105, 92, 41, 55, 46, 245, 40, 244, 102, 143, 54,
+    65, 25, 63, 161, 1, 216, 80, 73, 209, 76, 132, 187, 208, 89, 18, 169,
+    200, 196, 135, 130, 116, 188, 159, 86, 164, 100, 109, 198, 173, 186, 3, 64,
+    52, 217, 226, 250, 124, 123, 5, 202, 38, 147, 118, 126, 255, 82, 85, 212,
+    207, 206, 59, 227, 47, 16, 58, 17, 182, 189, 28, 42, 223, 183, 170, 213,
+    119, 248, 152, 2, 44, 154, 163, 70, 221, 153, 101, 155, 167, 43, 172, 9,
+    129, 22, 39, 253, 19, 98, 108, 110, 79, 113, 224, 232, 178, 185, 112, 104,
+    218, 246, 97, 228, 251, 34, 242, 193, 238, 210, 144, 12, 191, 179, 162, 241,
+    81, 51, 145, 235, 249, 14, 239, 107, 49, 192, 214, 31, 181, 199, 106, 157,
+    184, 84, 204, 176, 115, 121, 50, 45, 127, 4, 150, 254, 138, 236, 205, 93,
+    222, 114, 67, 29, 24, 72, 243, 141, 128, 195, 78, 66, 215, 61, 156, 180};
+
+static inline uint8_t P(int i) { return kPerm[i & 0xFF]; }
+static inline float fadeCurve(float t) { return t * t * t * (t * (t * 6 - 15) + 10); }
+static inline float lerpf(float a, float b, float t) { return a + t * (b - a); }
+static inline float gradf(int hash, float x, float y, float z) {
+    int h = hash & 15;
+    float u = h < 8 ? x : y;
+    float v = h < 4 ? y : (h == 12 || h == 14) ? x : z;
+    return ((h & 1) ? -u : u) + ((h & 2) ? -v : v);
+}
+
+// Returns roughly -1..1.
+static float perlin3(int X, int Y, int Z, float x, float y, float z) {
+    float u = fadeCurve(x), v = fadeCurve(y), w = fadeCurve(z);
+    int A = P(X) + Y, AA = P(A) + Z, AB = P(A + 1) + Z;
+    int B = P(X + 1) + Y, BA = P(B) + Z, BB = P(B + 1) + Z;
+    return lerpf(lerpf(lerpf(gradf(P(AA), x, y, z), gradf(P(BA), x - 1, y, z), u),
+                       lerpf(gradf(P(AB), x, y - 1, z), gradf(P(BB), x - 1, y - 1, z), u), v),
+                 lerpf(lerpf(gradf(P(AA + 1), x, y, z - 1), gradf(P(BA + 1), x - 1, y, z - 1), u),
+                       lerpf(gradf(P(AB + 1), x, y - 1, z - 1), gradf(P(BB + 1), x - 1, y - 1, z - 1), u),
+                       v),
+                 w);
+}
+
+static uint8_t toU8(float n) {
+    int v = (int)((n * 0.5f + 0.5f) * 255.0f);
+    return (uint8_t)constrain(v, 0, 255);
+}
+
+uint8_t inoise8(uint16_t x, uint16_t y, uint16_t z) {
+    return toU8(perlin3(x >> 8, y >> 8, z >> 8, (x & 0xFF) / 256.0f, (y & 0xFF) / 256.0f,
+                        (z & 0xFF) / 256.0f));
+}
+uint8_t inoise8(uint16_t x, uint16_t y) { return inoise8(x, y, 0); }
+uint8_t inoise8(uint16_t x) { return inoise8(x, 0, 0); }
+
+uint16_t inoise16(uint32_t x, uint32_t y, uint32_t z) {
+    float n = perlin3(x >> 16, y >> 16, z >> 16, (x & 0xFFFF) / 65536.0f,
+                      (y & 0xFFFF) / 65536.0f, (z & 0xFFFF) / 65536.0f);
+    int v = (int)((n * 0.5f + 0.5f) * 65535.0f);
+    return (uint16_t)constrain(v, 0, 65535);
+}
+uint16_t inoise16(uint32_t x, uint32_t y) { return inoise16(x, y, 0); }
+uint16_t inoise16(uint32_t x) { return inoise16(x, 0, 0); }
+
+// --- Controller -----------------------------------------------------------------
+CFastLED FastLED;
+
+void CFastLED::show() {
+    frameCount++;
+    if (onShow) onShow(controller.leds(), controller.size());
+
+    uint32_t now = millis();
+    fpsFrames++;
+    if (now - fpsStartMs >= 1000) {
+        fps = (uint16_t)((fpsFrames * 1000UL) / (now - fpsStartMs));
+        fpsFrames = 0;
+        fpsStartMs = now;
+    }
+}
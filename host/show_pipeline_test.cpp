@@ -0,0 +1,85 @@
+// ---------------------------------------------------------------------------
+// Host test for ShowPipeline (src/show_pipeline.h): a producer that renders
+// faster than a slow sender, checking the hand-off contract - every
+// published frame is transmitted exactly once and in order, and flush()
+// returns only once the sender has drained.
+//
+// Each frame carries its sequence number in the first pixel; FastLED.onShow
+// records it and sleeps to stand in for a slow strip transmit.
+//
+// Usage: show_pipeline_test [frames]    exit code 0 on pass, 1 on failure
+// ---------------------------------------------------------------------------
+#include <Arduino.h>
+#include <FastLED.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "show_pipeline.h"
+
+static CRGB strip[NUM_LEDS];
+static std::vector<uint32_t> shown;
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    if (ok) return;
+    printf("FAIL: %s\n", what);
+    failures++;
+}
+
+static void stampFrame(CRGB* frame, uint32_t id) {
+    frame[0] = CRGB((id >> 16) & 0xFF, (id >> 8) & 0xFF, id & 0xFF);
+    frame[NUM_LEDS - 1] = frame[0];
+}
+
+static uint32_t frameId(const CRGB* frame) {
+    return ((uint32_t)frame[0].r << 16) | ((uint32_t)frame[0].g << 8) | frame[0].b;
+}
+
+// Runs on the sender thread only; the producer reads `shown` after flush().
+static void slowShow(const CRGB* leds, int count) {
+    const uint32_t id = frameId(leds);
+    if (count != NUM_LEDS || frameId(leds + NUM_LEDS - 1) != id) {
+        shown.push_back(UINT32_MAX);  // torn or wrong buffer
+        return;
+    }
+    shown.push_back(id);
+    std::this_thread::sleep_for(std::chrono::microseconds(id % 3 == 0 ? 1500 : 300));
+}
+
+int main(int argc, char** argv) {
+    const uint32_t frames = argc > 1 ? (uint32_t)atoi(argv[1]) : 200;
+
+    FastLED.addLeds<WS2812B, 2, GRB>(strip, NUM_LEDS);
+    FastLED.onShow = slowShow;
+
+    {
+        ShowPipeline pipeline;
+        for (uint32_t id = 1; id <= frames; id++) {
+            stampFrame(pipeline.acquire(), id);
+            pipeline.publish();
+            // Every tenth frame the producer stalls instead, so the sender
+            // also runs dry and has to be woken.
+            if (id % 10 == 0) std::this_thread::sleep_for(std::chrono::milliseconds(3));
+        }
+        pipeline.flush();
+
+        check(pipeline.framesSent() == frames, "flush() returned before every frame was sent");
+        check(shown.size() == frames, "sender showed a different number of frames");
+        for (uint32_t i = 0; i < shown.size(); i++) {
+            if (shown[i] != i + 1) {
+                printf("FAIL: position %u showed frame %u, expected %u\n", i, shown[i], i + 1);
+                failures++;
+                break;
+            }
+        }
+        printf("%u frames published, %u sent, producer waited %u us\n", frames,
+               pipeline.framesSent(), pipeline.producerWaitMicros());
+    }
+
+    printf(failures ? "show_pipeline_test: FAILED\n" : "show_pipeline_test: ok\n");
+    return failures ? 1 : 0;
+}
@@ -6,6 +6,7 @@
 #include "vec2.h"
 #include "spatial_grid.h" // must precede boid.h
 #include "boid.h"
+#include "boid_swarm.h"
 #include "canvas.h"
 
 // ---------------------------------------------------------------------------
@@ -102,8 +103,28 @@ public:
         }
     }
 
-    PVector attract(Boid m) {
-        PVector force = location - m.location; // Direction of force
+    PVector attract(const Boid& m) const {
+        return attract(m.location.x, m.location.y, m.mass);
+    }
+
+    // Force on slot i of a BoidSwarm.
+    PVector attract(const BoidSwarm& swarm, uint16_t i) const {
+        return attract(swarm.x[i], swarm.y[i], swarm.params[i].mass);
+    }
+
+    // Accumulate this attractor's force on swarm slot i, computed in the same
+    // number format as the swarm physics (see BOID_PHYSICS_FIXED).
+    void applyTo(BoidSwarm& swarm, uint16_t i) const {
+        #if BOID_PHYSICS_FIXED
+        swarm.applyForce(i, attractFixed(swarm.x[i], swarm.y[i], swarm.params[i].mass));
+        #else
+        swarm.applyForce(i, attract(swarm, i));
+        #endif
+    }
+
+    // Force on a body of mass bodyMass at (bodyX, bodyY).
+    PVector attract(float bodyX, float bodyY, float bodyMass) const {
+        PVector force(location.x - bodyX, location.y - bodyY); // Direction of force
         float d = force.mag();                 // Distance between objects
 
         // Outside influence radius -> no force.
@@ -112,7 +133,7 @@ public:
         d = constrain(d, minDistance, maxInfluenceRadius);
         force.normalize();
 
-        float strength = (G * mass * m.mass) / (d * d);
+        float strength = (G * mass * bodyMass) / (d * d);
 
         if (isRepulsor) {
             force = force * -1;
@@ -133,6 +154,46 @@ public:
 
         return force;
     }
+
+    // Fixed-point twin of attract(float, float, float). The strength product
+    // is evaluated as (G * mass) / d^2 * bodyMass so intermediates stay within
+    // Q16.16 range for the masses used here; beyond that it saturates.
+    BoidSwarm::fixedvec_t attractFixed(float bodyX, float bodyY, float bodyMass) const {
+        typedef BoidSwarm::fixed_t fixed_t;
+        typedef BoidSwarm::fixedvec_t fixedvec_t;
+
+        fixedvec_t force = fixedvec_t::fromFloat(location.x, location.y) -
+                           fixedvec_t::fromFloat(bodyX, bodyY);
+        fixed_t d = force.length();
+
+        const fixed_t maxDist = fixed_t::fromFloat(maxInfluenceRadius);
+        const fixed_t minDist = fixed_t::fromFloat(minDistance);
+        if (d > maxDist) return fixedvec_t();
+
+        if (d < minDist) d = minDist;
+        if (d > maxDist) d = maxDist;
+        force.normalize();
+
+        fixed_t strength = fixed_t::fromFloat(G) * fixed_t::fromFloat(mass) / (d * d) *
+                           fixed_t::fromFloat(bodyMass);
+
+        if (isRepulsor) {
+            force = force * fixed_t::fromInt(-1);
+        }
+
+        force *= strength;
+
+        if (hasVortex && strength > fixed_t::fromFloat(0.001f)) {
+            fixedvec_t tangent = force.ortho();
+            if (tangent.length() > fixed_t::fromFloat(0.001f)) {
+                tangent.normalize();
+                tangent *= strength * fixed_t::fromFloat(vortexStrength);
+                force += tangent;
+            }
+        }
+
+        return force;
+    }
 };
 
 #endif // ATTRACTOR_H
@@ -0,0 +1,131 @@
+#ifndef ATTRACTOR_FIELD_H
+#define ATTRACTOR_FIELD_H
+
+#include <Arduino.h>
+#include "vec2.h"
+#include "boid_swarm.h"
+#include "attractor.h"
+
+// ---------------------------------------------------------------------------
+// AttractorField: every active attractor's force on the whole flock in one
+// batched pass.
+//
+// Instead of each boid walking the attractor list and re-reading every
+// Attractor's members (and, before, copying itself by value into attract()),
+// the active attractors are packed once per frame into flat arrays:
+// position, G*mass, min/max influence radius, repulsor sign and vortex
+// strength. apply() then runs one tight boids x attractors loop that adds the
+// summed force into the swarm's acceleration arrays.
+//
+// The per-pair math is float-only but keeps Attractor::attract()'s distance
+// scale: the distance is fastSqrt() of the squared distance - the sqrt table,
+// which reads about half the true distance below SQRT_TABLE_RANGE - and it
+// drives the radius test, the direction and the 1/d^2 strength just as in
+// attract() (and in attractFixed() through fixedFastSqrt()). Only the
+// PVector temporaries and double intermediates are gone, so forces match
+// attract() to the last bit or so.
+//
+// Forces only depend on each boid's own position and mass, so applying them
+// for all boids before the flocking loop is equivalent to applying them boid
+// by boid inside it.
+// ---------------------------------------------------------------------------
+class AttractorField {
+public:
+    static const uint8_t MAX_ATTRACTORS = 24;
+
+    void clear() { count = 0; }
+
+    // Append an attractor's current state. Returns false if the field is full.
+    bool add(const Attractor& a) {
+        if (count >= MAX_ATTRACTORS) return false;
+        source[count] = &a;
+        x[count] = a.location.x;
+        y[count] = a.location.y;
+        gm[count] = a.G * a.mass;
+        minDist[count] = a.minDistance;
+        maxDist[count] = a.maxInfluenceRadius;
+        sign[count] = a.isRepulsor ? -1.0F : 1.0F;
+        vortex[count] = a.hasVortex ? a.vortexStrength : 0.0F;
+        hasVortex[count] = a.hasVortex;
+        count++;
+        return true;
+    }
+
+    uint8_t size() const { return count; }
+
+    // The k-th attractor added, for checks against the per-attractor path.
+    const Attractor& attractor(uint8_t k) const { return *source[k]; }
+
+    // Add the field's force to the acceleration of swarm slots [0, n).
+    void apply(BoidSwarm& swarm, uint16_t n) const {
+        #if BOID_PHYSICS_FIXED
+        // Fixed-point physics keeps its own per-attractor path.
+        for (uint16_t i = 0; i < n; i++) {
+            for (uint8_t k = 0; k < count; k++) {
+                source[k]->applyTo(swarm, i);
+            }
+        }
+        #else
+        for (uint16_t i = 0; i < n; i++) {
+            accumulate(swarm.x[i], swarm.y[i], swarm.params[i].mass, swarm.ax[i], swarm.ay[i]);
+        }
+        #endif
+    }
+
+    // Summed force on a body of mass bodyMass at (bx, by).
+    PVector forceAt(float bx, float by, float bodyMass) const {
+        float fx = 0;
+        float fy = 0;
+        accumulate(bx, by, bodyMass, fx, fy);
+        return PVector(fx, fy);
+    }
+
+    // Add each attractor's force on a body at (bx, by) to (ax, ay), in order.
+    void accumulate(float bx, float by, float bodyMass, float& ax, float& ay) const {
+        for (uint8_t k = 0; k < count; k++) {
+            const float dx = x[k] - bx;
+            const float dy = y[k] - by;
+            const float d = fastSqrt(dx * dx + dy * dy);
+            if (d > maxDist[k]) continue;
+
+            // d is at most maxDist here, so constrain(d, min, max) only
+            // needs the lower clamp. A table distance of 0 (squared distance
+            // under 4) leaves the direction unnormalized, as normalize() does.
+            const float dc = d < minDist[k] ? minDist[k] : d;
+            const float strength = gm[k] * bodyMass / (dc * dc);
+            const float s = strength * sign[k];
+            float fx = (d > 0.0F ? dx / d : dx) * s;
+            float fy = (d > 0.0F ? dy / d : dy) * s;
+
+            // Vortex: ortho(force) = (fy, -fx), normalized by its own table
+            // length and scaled by strength * vortexStrength.
+            if (hasVortex[k] && strength > 0.001F) {
+                const float len = fastSqrt(fy * fy + fx * fx);
+                if (len > 0.001F) {
+                    const float t = strength * vortex[k];
+                    const float tx = fy / len * t;
+                    const float ty = -fx / len * t;
+                    fx += tx;
+                    fy += ty;
+                }
+            }
+
+            ax += fx;
+            ay += fy;
+        }
+    }
+
+private:
+    uint8_t count = 0;
+    const Attractor* source[MAX_ATTRACTORS];
+    float x[MAX_ATTRACTORS];
+    float y[MAX_ATTRACTORS];
+    float gm[MAX_ATTRACTORS];       // G * mass
+    float minDist[MAX_ATTRACTORS];  // influence radii
+    float maxDist[MAX_ATTRACTORS];
+    float sign[MAX_ATTRACTORS];     // -1 for repulsors
+    float vortex[MAX_ATTRACTORS];
+    bool hasVortex[MAX_ATTRACTORS];
+};
+
+#endif // ATTRACTOR_FIELD_H
@@ -0,0 +1,143 @@
+#ifndef ATTRACTOR_GRID_H
+#define ATTRACTOR_GRID_H
+
+#include <Arduino.h>
+#include "vec2.h"
+#include "boid_swarm.h"
+#include "attractor_field.h"
+
+// Default sample resolution (cells per side) of the attractor force grid.
+// The grid holds (res + 1)^2 samples, so it only costs less than the exact
+// path while that stays below the boid count: 12 (169 samples) for the
+// 254-boid flock. 24 or 48 are sharper but rasterize more points than there
+// are boids. Also the finest resolution setResolution() accepts.
+#ifndef ATTRACTOR_GRID_RES
+#define ATTRACTOR_GRID_RES 12
+#endif
+
+// ---------------------------------------------------------------------------
+// AttractorForceGrid: the combined attractor field rasterized onto a coarse
+// grid, sampled bilinearly by the boids.
+//
+// Attractor force is linear in the body's mass, so the grid stores force per
+// unit mass at every cell corner of a res x res grid over the world. Each
+// frame rasterize() evaluates the packed AttractorField once per corner and
+// apply() gives every boid its bilinear sample scaled by its mass: the cost
+// becomes O(samples * attractors + boids) instead of O(boids * attractors).
+//
+// It is an approximation. Near an attractor the 1/d^2 falloff is sharper than
+// a cell, and the vortex cutoff (strength > 0.001) is applied per unit mass.
+// measureError() compares the grid against the exact per-attractor path,
+// Attractor::attract() summed over the field's attractors, for the current
+// flock so the trade-off can be judged per attractor pattern.
+// ---------------------------------------------------------------------------
+class AttractorForceGrid {
+public:
+    // Storage is sized for ATTRACTOR_GRID_RES at compile time (1.4 KB at the
+    // default 12); setResolution() can go coarser, not finer.
+    static const uint8_t MAX_RES = ATTRACTOR_GRID_RES;
+
+    AttractorForceGrid(float worldWidth, float worldHeight, uint8_t res = ATTRACTOR_GRID_RES)
+        : worldWidth(worldWidth), worldHeight(worldHeight) {
+        setResolution(res);
+    }
+
+    void setResolution(uint8_t res) {
+        this->res = constrain(res, 1, MAX_RES);
+        cellWidth = worldWidth / this->res;
+        cellHeight = worldHeight / this->res;
+    }
+
+    uint8_t resolution() const { return res; }
+
+    // Sample the field (per unit mass) at every cell corner.
+    void rasterize(const AttractorField& field) {
+        const uint8_t stride = res + 1;
+        for (uint8_t gy = 0; gy <= res; gy++) {
+            for (uint8_t gx = 0; gx <= res; gx++) {
+                PVector f = field.forceAt(gx * cellWidth, gy * cellHeight, 1.0F);
+                fx[gy * stride + gx] = f.x;
+                fy[gy * stride + gx] = f.y;
+            }
+        }
+    }
+
+    // Bilinear force sample for a body of mass bodyMass at (px, py).
+    // Positions outside the world are clamped to its edge.
+    PVector sample(float px, float py, float bodyMass) const {
+        float u = constrain(px / cellWidth, 0.0F, (float)res);
+        float v = constrain(py / cellHeight, 0.0F, (float)res);
+        uint8_t gx = min((uint8_t)u, (uint8_t)(res - 1));
+        uint8_t gy = min((uint8_t)v, (uint8_t)(res - 1));
+        float tx = u - gx;
+        float ty = v - gy;
+
+        const uint8_t stride = res + 1;
+        const int i00 = gy * stride + gx;
+        const int i10 = i00 + 1;
+        const int i01 = i00 + stride;
+        const int i11 = i01 + 1;
+
+        float top = fx[i00] + (fx[i10] - fx[i00]) * tx;
+        float bottom = fx[i01] + (fx[i11] - fx[i01]) * tx;
+        float sx = top + (bottom - top) * ty;
+
+        top = fy[i00] + (fy[i10] - fy[i00]) * tx;
+        bottom = fy[i01] + (fy[i11] - fy[i01]) * tx;
+        float sy = top + (bottom - top) * ty;
+
+        return PVector(sx * bodyMass, sy * bodyMass);
+    }
+
+    // Add the sampled force to the acceleration of swarm slots [0, n).
+    void apply(BoidSwarm& swarm, uint16_t n) const {
+        for (uint16_t i = 0; i < n; i++) {
+            swarm.applyForce(i, sample(swarm.x[i], swarm.y[i], swarm.params[i].mass));
+        }
+    }
+
+    struct ErrorStats {
+        float maxError;  // largest |grid - exact| over the flock
+        float meanError; // average |grid - exact|
+        float maxExact;  // largest exact force magnitude, for scale
+    };
+
+    // Compare the grid against Attractor::attract() summed over the field's
+    // attractors for swarm slots [0, n). Evaluates every attractor for
+    // every boid, so call it occasionally (diagnostics), not every frame.
+    ErrorStats measureError(const AttractorField& field, const BoidSwarm& swarm, uint16_t n) const {
+        ErrorStats stats = {0, 0, 0};
+        float total = 0;
+        for (uint16_t i = 0; i < n; i++) {
+            const float mass = swarm.params[i].mass;
+            PVector exact(0, 0);
+            for (uint8_t k = 0; k < field.size(); k++) {
+                const PVector f = field.attractor(k).attract(swarm.x[i], swarm.y[i], mass);
+                exact.x += f.x;
+                exact.y += f.y;
+            }
+            PVector approx = sample(swarm.x[i], swarm.y[i], mass);
+            float ex = approx.x - exact.x;
+            float ey = approx.y - exact.y;
+            float err = sqrtf(ex * ex + ey * ey);
+            total += err;
+            stats.maxError = max(stats.maxError, err);
+            stats.maxExact = max(stats.maxExact, sqrtf(exact.x * exact.x + exact.y * exact.y));
+        }
+        if (n > 0) stats.meanError = total / n;
+        return stats;
+    }
+
+private:
+    float worldWidth;
+    float worldHeight;
+    float cellWidth;
+    float cellHeight;
+    uint8_t res;
+
+    // Per-unit-mass force at the (res + 1)^2 cell corners, row-major.
+    float fx[(MAX_RES + 1) * (MAX_RES + 1)];
+    float fy[(MAX_RES + 1) * (MAX_RES + 1)];
+};
+
+#endif // ATTRACTOR_GRID_H
@@ -5,9 +5,7 @@
 #include "vec2.h"
 #include "simd_utils.h"
 #include "algorithm"
-
-// Forward declaration
-class SpatialGrid;
+#include "spatial_grid.h"
 
 // Boid class to make the particles interact with each other
 class Boid {
@@ -228,14 +226,17 @@ public:
         location.y = height - 1;
     }
 
-    // Optimized version of separate that uses spatial partitioning
-    PVector separate(std::vector<void*>& neighbors) {
+    // Optimized version of separate that uses spatial partitioning.
+    // Neighbors come from the grid cells around this boid's location, queried
+    // with the neighbordist radius (the same set align/cohesion see). The grid
+    // holds indices into `flock`, the array it was last rebuilt from.
+    PVector separate(const SpatialGrid& grid, Boid* flock) {
         PVector steer = PVector(0.0F, 0.0F);
         int count = 0;
         
-        // For every boid in the system, check if it's too close
-        for (void* obj : neighbors) {
-            Boid* other = static_cast<Boid*>(obj);
+        // For every nearby boid, check if it's too close
+        grid.forEachNeighbor(location.x, location.y, neighbordist, [&](SpatialGrid::Index j) {
+            Boid* other = &flock[j];
             if (other != this && other->enabled) {
                 float d = location.dist(other->location);
                 // If the distance is greater than 0 and less than an arbitrary amount (0 when you are yourself)
@@ -248,7 +249,7 @@ public:
                     count++;            // Keep track of how many
                 }
             }
-        }
+        });
         // Average -- divide by how many
         if (count > 0) {
             steer /= (float)count;
@@ -266,12 +267,12 @@ public:
     }
 
     // Optimized version of align that uses spatial partitioning
-    PVector align(std::vector<void*>& neighbors) {
+    PVector align(const SpatialGrid& grid, Boid* flock) {
         PVector sum = PVector(0.0F, 0.0F);
         int count = 0;
         
-        for (void* obj : neighbors) {
-            Boid* other = static_cast<Boid*>(obj);
+        grid.forEachNeighbor(location.x, location.y, neighbordist, [&](SpatialGrid::Index j) {
+            Boid* other = &flock[j];
             if (other != this && other->enabled) {
                 float d = location.dist(other->location);
                 if ((d > 0) && (d < neighbordist)) {
@@ -279,7 +280,7 @@ public:
                     count++;
                 }
             }
-        }
+        });
         
         if (count > 0) {
             sum /= (float)count;
@@ -294,12 +295,12 @@ public:
     }
 
     // Optimized version of cohesion that uses spatial partitioning
-    PVector cohesion(std::vector<void*>& neighbors) {
+    PVector cohesion(const SpatialGrid& grid, Boid* flock) {
         PVector sum = PVector(0.0F, 0.0F);
         int count = 0;
         
-        for (void* obj : neighbors) {
-            Boid* other = static_cast<Boid*>(obj);
+        grid.forEachNeighbor(location.x, location.y, neighbordist, [&](SpatialGrid::Index j) {
+            Boid* other = &flock[j];
             if (other != this && other->enabled) {
                 float d = location.dist(other->location);
                 if ((d > 0) && (d < neighbordist)) {
@@ -307,7 +308,7 @@ public:
                     count++;
                 }
             }
-        }
+        });
         
         if (count > 0) {
             sum /= (float)count;
@@ -318,14 +319,13 @@ public:
     }
     
     // Update with spatial grid optimization
-    void update(SpatialGrid& grid) {
-        // Get only neighboring boids from the spatial grid
-        std::vector<void*> neighbors = grid.getNeighbors(location.x, location.y, neighbordist);
-        
-        // Calculate steering forces
-        PVector sep = separate(neighbors);
-        PVector ali = align(neighbors);
-        PVector coh = cohesion(neighbors);
+    // `grid` must have been rebuilt from `flock` (see SpatialGrid::rebuild).
+    void update(SpatialGrid& grid, Boid* flock) {
+        // Calculate steering forces from neighboring boids only (no allocation:
+        // each rule walks the nearby grid cells directly)
+        PVector sep = separate(grid, flock);
+        PVector ali = align(grid, flock);
+        PVector coh = cohesion(grid, flock);
         
         // Arbitrarily weight these forces
         sep *= 3.5;
@@ -0,0 +1,522 @@
+#ifndef BOID_SWARM_H
+#define BOID_SWARM_H
+
+#include <Arduino.h>
+#include "vec2.h"
+#include "spatial_grid.h" // must precede boid.h
+#include "boid.h"
+#include "fixed_point.h"
+
+// Default flocking backend (see BoidSwarm::Backend): 1 = fused single-pass
+// kernel, 0 = original three-pass separate/align/cohesion. Both produce the
+// same motion; switchable at runtime via BoidSwarm::backend.
+#ifndef BOID_FLOCKING_FUSED
+#define BOID_FLOCKING_FUSED 1
+#endif
+
+// Fixed-point physics: 1 = flocking, attractor forces and integration run in
+// Fixed<BOID_FIXED_FRAC> integer math (bit-exact across the S3 and a host
+// build, for replayable regression runs); 0 = float (default). 16 gives
+// Q16.16; 8 gives Q24.8 - 8 fractional bits, coarser but still stable on the
+// 48x48 world.
+#ifndef BOID_PHYSICS_FIXED
+#define BOID_PHYSICS_FIXED 0
+#endif
+#ifndef BOID_FIXED_FRAC
+#define BOID_FIXED_FRAC 16
+#endif
+
+// ---------------------------------------------------------------------------
+// BoidSwarm: structure-of-arrays storage for the whole flock.
+//
+// Boid keeps every property of a particle in one ~60-byte object, so a
+// neighbor test that only needs a position still drags the whole object
+// through the cache. BoidSwarm stores the hot per-frame components (position,
+// velocity, accumulated acceleration) in one contiguous array each, and packs
+// the rarely-touched per-boid scalars into a separate Params array.
+//
+// The flocking step, attractor forces and the renderer all work on the arrays
+// directly. The math is the same as Boid::update(SpatialGrid&, Boid*) - it
+// builds PVectors on the stack and calls the same vec2 helpers - so a flock
+// stepped here moves exactly like the equivalent Boid array. Boid itself stays
+// available: get()/set() convert between the two, and BoidView offers the
+// familiar per-boid accessors on top of the arrays.
+//
+// The spatial grid is rebuilt from the position arrays and hands back slot
+// indices directly.
+//
+// With BOID_PHYSICS_FIXED the arrays stay float but only ever hold values on
+// the fixed-point grid: every physics step converts in, computes in Fixed and
+// converts back, and Q16.16 values below 256 round-trip through float
+// exactly. Renderers and effects keep reading plain floats either way.
+// ---------------------------------------------------------------------------
+class BoidSwarm {
+public:
+    static const uint16_t CAPACITY = 255;
+
+    // Cold per-boid scalars (read once per boid per frame).
+    struct Params {
+        float maxspeed;
+        float maxforce;
+        float mass;
+        float desiredseparation; // separation radius (see Boid::desiredseparation)
+        float neighbordist;      // alignment/cohesion radius (see Boid::neighbordist)
+        int16_t hue;
+        uint8_t brightness;
+        uint8_t colorIndex;
+        bool enabled;
+    };
+
+    // Hot per-frame components, one array each.
+    float x[CAPACITY];
+    float y[CAPACITY];
+    float vx[CAPACITY];
+    float vy[CAPACITY];
+    float ax[CAPACITY];
+    float ay[CAPACITY];
+    Params params[CAPACITY];
+
+    // Every slot starts out like a default-constructed Boid: at rest at the
+    // origin, enabled, with Boid's default interaction radii.
+    BoidSwarm() {
+        for (uint16_t i = 0; i < CAPACITY; i++) {
+            x[i] = y[i] = vx[i] = vy[i] = ax[i] = ay[i] = 0;
+            Params& p = params[i];
+            p.maxspeed = p.maxforce = p.mass = 0;
+            p.desiredseparation = 1.0F;
+            p.neighbordist = 2.0F;
+            p.hue = 0;
+            p.brightness = 0;
+            p.colorIndex = 0;
+            p.enabled = true;
+        }
+    }
+
+    // --- Conversion to/from the AoS Boid -------------------------------------
+    // (Re)initialize slot i as a fresh boid at (px, py), using the Boid
+    // constructor so defaults and random draws stay in one place.
+    void spawn(uint16_t i, float px, float py) { set(i, Boid(px, py)); }
+
+    void set(uint16_t i, const Boid& b) {
+        x[i] = b.location.x;
+        y[i] = b.location.y;
+        vx[i] = b.velocity.x;
+        vy[i] = b.velocity.y;
+        ax[i] = b.acceleration.x;
+        ay[i] = b.acceleration.y;
+        Params& p = params[i];
+        p.maxspeed = b.maxspeed;
+        p.maxforce = b.maxforce;
+        p.mass = b.mass;
+        p.desiredseparation = b.desiredseparation;
+        p.neighbordist = b.neighbordist;
+        p.hue = b.hue;
+        p.brightness = b.brightness;
+        p.colorIndex = b.colorIndex;
+        p.enabled = b.enabled;
+    }
+
+    Boid get(uint16_t i) const {
+        Boid b;
+        b.location = PVector(x[i], y[i]);
+        b.velocity = PVector(vx[i], vy[i]);
+        b.acceleration = PVector(ax[i], ay[i]);
+        const Params& p = params[i];
+        b.maxspeed = p.maxspeed;
+        b.maxforce = p.maxforce;
+        b.mass = p.mass;
+        b.desiredseparation = p.desiredseparation;
+        b.neighbordist = p.neighbordist;
+        b.hue = p.hue;
+        b.brightness = p.brightness;
+        b.colorIndex = p.colorIndex;
+        b.enabled = p.enabled;
+        return b;
+    }
+
+    // --- Spatial grid ---------------------------------------------------------
+    // Rebuild the grid from the first n boids.
+    void populateGrid(SpatialGrid& grid, uint16_t n) {
+        grid.rebuild(n, [this](SpatialGrid::Index i, float& px, float& py) {
+            px = x[i];
+            py = y[i];
+        });
+    }
+
+    // --- Per-boid physics -----------------------------------------------------
+    void applyForce(uint16_t i, PVector force) {
+        ax[i] += force.x;
+        ay[i] += force.y;
+    }
+
+    // Fixed-point physics types (used when BOID_PHYSICS_FIXED is set).
+    typedef Fixed<BOID_FIXED_FRAC> fixed_t;
+    typedef FixedVec2<BOID_FIXED_FRAC> fixedvec_t;
+
+    void applyForce(uint16_t i, fixedvec_t force) {
+        ax[i] = (fixed_t::fromFloat(ax[i]) + force.x).toFloat();
+        ay[i] = (fixed_t::fromFloat(ay[i]) + force.y).toFloat();
+    }
+
+    void wrapAroundBorders(uint16_t i, float width, float height) {
+        if (x[i] < 0) x[i] = width - 1;
+        if (y[i] < 0) y[i] = height - 1;
+        if (x[i] >= width) x[i] = 0;
+        if (y[i] >= height) y[i] = 0;
+    }
+
+    // Flocking + integration for boid i (same behavior as
+    // Boid::update(SpatialGrid&, Boid*)). Neighbors are read live, so boids
+    // updated earlier in the frame are seen at their new positions, as before.
+    void update(uint16_t i, SpatialGrid& grid) {
+        #if BOID_PHYSICS_FIXED
+        updateFixed(i, grid);
+        return;
+        #endif
+
+        PVector sep, ali, coh;
+        if (backend == FLOCKING_FUSED) {
+            steerFused(i, grid, sep, ali, coh);
+        } else {
+            sep = separate(i, grid);
+            ali = align(i, grid);
+            coh = cohesion(i, grid);
+        }
+
+        // Arbitrarily weight these forces
+        sep *= 3.5;
+        ali *= 1.0;
+        coh *= 1.0;
+
+        applyForce(i, sep);
+        applyForce(i, ali);
+        applyForce(i, coh);
+
+        PVector velocity(vx[i] + ax[i], vy[i] + ay[i]);
+        velocity.limit(params[i].maxspeed);
+        vx[i] = velocity.x;
+        vy[i] = velocity.y;
+        x[i] += velocity.x;
+        y[i] += velocity.y;
+        ax[i] = 0;
+        ay[i] = 0;
+
+        params[i].hue = (params[i].hue + random8(1, 10)) % 255;
+    }
+
+    // --- Flocking backends ----------------------------------------------------
+    // THREE_PASS is the original separate/align/cohesion trio, each walking the
+    // neighbor cells and taking a table sqrt per neighbor. FUSED visits each
+    // neighbor once and produces bit-identical steering (see steerFused), so
+    // the two can be A/B'd on hardware without the animation changing.
+    enum Backend : uint8_t {
+        FLOCKING_THREE_PASS = 0,
+        FLOCKING_FUSED
+    };
+
+    Backend backend = BOID_FLOCKING_FUSED ? FLOCKING_FUSED : FLOCKING_THREE_PASS;
+
+    static const char* backendName(Backend b) {
+        #if BOID_PHYSICS_FIXED
+        (void)b;
+        return "fixed";
+        #else
+        return b == FLOCKING_FUSED ? "fused" : "three-pass";
+        #endif
+    }
+
+private:
+    // Single pass over the neighbor cells accumulating all three rules.
+    //
+    // Distances are never taken for the radius tests. fastSqrt() is a table
+    // lookup, so "fastSqrt(d2) < r" is the same as comparing d2's table index
+    // against a per-radius bound (fastSqrtIndexBound), computed once here; the
+    // "d > 0" test is "index >= 1". Only separation, which weights by 1/d and
+    // normalizes, reads the table per neighbor. Each sum still accumulates in
+    // neighbor order with the same operations as the three-pass path, so the
+    // result matches it exactly.
+    void steerFused(uint16_t i, const SpatialGrid& grid, PVector& sep, PVector& ali, PVector& coh) {
+        const float xi = x[i];
+        const float yi = y[i];
+        const float desiredseparation = params[i].desiredseparation;
+        const float neighbordist = params[i].neighbordist;
+        const uint16_t sepBound = fastSqrtIndexBound(desiredseparation);
+        const uint16_t nbrBound = fastSqrtIndexBound(neighbordist);
+
+        PVector sepSum(0.0F, 0.0F);
+        PVector velSum(0.0F, 0.0F);
+        PVector posSum(0.0F, 0.0F);
+        int sepCount = 0;
+        int nbrCount = 0;
+
+        grid.forEachNeighbor(xi, yi, neighbordist, [&](SpatialGrid::Index j) {
+            if (j == i || !params[j].enabled) return;
+
+            float dx = x[j] - xi;
+            float dy = y[j] - yi;
+            float d2 = dx * dx + dy * dy;
+            if (d2 <= 0) return;
+
+            bool inSep, inNbr;
+            if (d2 < SQRT_TABLE_RANGE) {
+                uint16_t k = fastSqrtIndex(d2);
+                if (k == 0) return; // fastSqrt() would report d == 0
+                inSep = k < sepBound;
+                inNbr = k < nbrBound;
+            } else {
+                float d = fastSqrt(d2);
+                inSep = d < desiredseparation;
+                inNbr = d < neighbordist;
+            }
+
+            if (inSep) {
+                float d = fastSqrt(d2);
+                PVector diff(xi - x[j], yi - y[j]);
+                diff.normalize();
+                diff /= d;
+                sepSum += diff;
+                sepCount++;
+            }
+            if (inNbr) {
+                PVector otherVelocity(vx[j], vy[j]);
+                PVector other(x[j], y[j]);
+                velSum += otherVelocity;
+                posSum += other;
+                nbrCount++;
+            }
+        });
+
+        sep = separationSteer(i, sepSum, sepCount);
+        ali = alignmentSteer(i, velSum, nbrCount);
+        coh = cohesionSteer(i, posSum, nbrCount);
+    }
+
+    PVector separate(uint16_t i, const SpatialGrid& grid) {
+        PVector location(x[i], y[i]);
+        PVector steer(0.0F, 0.0F);
+        int count = 0;
+        const float desiredseparation = params[i].desiredseparation;
+
+        grid.forEachNeighbor(x[i], y[i], params[i].neighbordist, [&](SpatialGrid::Index j) {
+            if (j != i && params[j].enabled) {
+                PVector other(x[j], y[j]);
+                float d = location.dist(other);
+                if ((d > 0) && (d < desiredseparation)) {
+                    // Vector pointing away from the neighbor, weighted by distance.
+                    PVector diff = location - other;
+                    diff.normalize();
+                    diff /= d;
+                    steer += diff;
+                    count++;
+                }
+            }
+        });
+        return separationSteer(i, steer, count);
+    }
+
+    PVector align(uint16_t i, const SpatialGrid& grid) {
+        PVector location(x[i], y[i]);
+        PVector sum(0.0F, 0.0F);
+        int count = 0;
+        const float neighbordist = params[i].neighbordist;
+
+        grid.forEachNeighbor(x[i], y[i], params[i].neighbordist, [&](SpatialGrid::Index j) {
+            if (j != i && params[j].enabled) {
+                PVector other(x[j], y[j]);
+                float d = location.dist(other);
+                if ((d > 0) && (d < neighbordist)) {
+                    PVector otherVelocity(vx[j], vy[j]);
+                    sum += otherVelocity;
+                    count++;
+                }
+            }
+        });
+        return alignmentSteer(i, sum, count);
+    }
+
+    PVector cohesion(uint16_t i, const SpatialGrid& grid) {
+        PVector location(x[i], y[i]);
+        PVector sum(0.0F, 0.0F);
+        int count = 0;
+        const float neighbordist = params[i].neighbordist;
+
+        grid.forEachNeighbor(x[i], y[i], params[i].neighbordist, [&](SpatialGrid::Index j) {
+            if (j != i && params[j].enabled) {
+                PVector other(x[j], y[j]);
+                float d = location.dist(other);
+                if ((d > 0) && (d < neighbordist)) {
+                    sum += other;
+                    count++;
+                }
+            }
+        });
+        return cohesionSteer(i, sum, count);
+    }
+
+    // Fixed-point flocking + integration: the fused kernel's single neighbor
+    // pass with the three-pass path's distance tests (table sqrt, then
+    // compare), all in Fixed. Ignores `backend`.
+    void updateFixed(uint16_t i, const SpatialGrid& grid) {
+        const fixedvec_t location = fixedvec_t::fromFloat(x[i], y[i]);
+        const fixed_t desiredseparation = fixed_t::fromFloat(params[i].desiredseparation);
+        const fixed_t neighbordist = fixed_t::fromFloat(params[i].neighbordist);
+
+        fixedvec_t sepSum, velSum, posSum;
+        int sepCount = 0;
+        int nbrCount = 0;
+
+        grid.forEachNeighbor(x[i], y[i], params[i].neighbordist, [&](SpatialGrid::Index j) {
+            if (j == i || !params[j].enabled) return;
+
+            fixedvec_t other = fixedvec_t::fromFloat(x[j], y[j]);
+            fixedvec_t diff = location - other;
+            fixed_t d = diff.length();
+            if (d.raw <= 0) return;
+
+            if (d < desiredseparation) {
+                diff.normalize();
+                diff /= d;
+                sepSum += diff;
+                sepCount++;
+            }
+            if (d < neighbordist) {
+                velSum += fixedvec_t::fromFloat(vx[j], vy[j]);
+                posSum += other;
+                nbrCount++;
+            }
+        });
+
+        const fixedvec_t velocity = fixedvec_t::fromFloat(vx[i], vy[i]);
+        const fixed_t maxspeed = fixed_t::fromFloat(params[i].maxspeed);
+        const fixed_t maxforce = fixed_t::fromFloat(params[i].maxforce);
+
+        // Separation
+        fixedvec_t sep = sepSum;
+        if (sepCount > 0) sep /= fixed_t::fromInt(sepCount);
+        if (sep.length().raw > 0) {
+            sep.normalize();
+            sep *= maxspeed;
+            sep -= velocity;
+            sep.limit(maxforce);
+        }
+
+        // Alignment + cohesion
+        fixedvec_t ali, coh;
+        if (nbrCount > 0) {
+            const fixed_t n = fixed_t::fromInt(nbrCount);
+            ali = velSum / n;
+            ali.normalize();
+            ali *= maxspeed;
+            ali -= velocity;
+            ali.limit(maxforce);
+
+            coh = posSum / n - location;
+            coh.normalize();
+            coh *= maxspeed;
+            coh -= velocity;
+            coh.limit(maxforce);
+        }
+
+        // Same weights as the float path (3.5 / 1.0 / 1.0)
+        sep *= fixed_t::fromRaw(fixed_t::ONE * 7 / 2);
+
+        fixedvec_t accel = fixedvec_t::fromFloat(ax[i], ay[i]);
+        accel += sep;
+        accel += ali;
+        accel += coh;
+
+        fixedvec_t v = velocity + accel;
+        v.limit(maxspeed);
+        fixedvec_t p = location + v;
+        vx[i] = v.x.toFloat();
+        vy[i] = v.y.toFloat();
+        x[i] = p.x.toFloat();
+        y[i] = p.y.toFloat();
+        ax[i] = 0;
+        ay[i] = 0;
+
+        params[i].hue = (params[i].hue + random8(1, 10)) % 255;
+    }
+
+    // --- Steering from accumulated neighbor sums (shared by both backends) ---
+    PVector separationSteer(uint16_t i, PVector steer, int count) {
+        if (count > 0) {
+            steer /= (float)count;
+        }
+
+        if (steer.mag() > 0) {
+            // Reynolds: Steering = Desired - Velocity
+            PVector velocity(vx[i], vy[i]);
+            steer.normalize();
+            steer *= params[i].maxspeed;
+            steer -= velocity;
+            steer.limit(params[i].maxforce);
+        }
+        return steer;
+    }
+
+    PVector alignmentSteer(uint16_t i, PVector sum, int count) {
+        if (count > 0) {
+            PVector velocity(vx[i], vy[i]);
+            sum /= (float)count;
+            sum.normalize();
+            sum *= params[i].maxspeed;
+            PVector steer = sum - velocity;
+            steer.limit(params[i].maxforce);
+            return steer;
+        }
+        return PVector(0.0F, 0.0F);
+    }
+
+    PVector cohesionSteer(uint16_t i, PVector sum, int count) {
+        if (count > 0) {
+            sum /= (float)count;
+            return seek(i, sum);
+        }
+        return PVector(0.0F, 0.0F);
+    }
+
+    PVector seek(uint16_t i, PVector target) {
+        PVector location(x[i], y[i]);
+        PVector velocity(vx[i], vy[i]);
+        PVector desired = target - location;
+        desired.normalize();
+        desired *= params[i].maxspeed;
+
+        PVector steer = desired - velocity;
+        steer.limit(params[i].maxforce);
+        return steer;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// BoidView: the old per-boid API as a thin handle onto one BoidSwarm slot.
+// Lets code written against Boid (location/velocity/applyForce/update/...)
+// operate on swarm storage without copying the boid out and back.
+// ---------------------------------------------------------------------------
+class BoidView {
+public:
+    BoidView(BoidSwarm& swarm, uint16_t index) : swarm(swarm), index(index) {}
+
+    PVector location() const { return PVector(swarm.x[index], swarm.y[index]); }
+    PVector velocity() const { return PVector(swarm.vx[index], swarm.vy[index]); }
+    PVector acceleration() const { return PVector(swarm.ax[index], swarm.ay[index]); }
+
+    void setLocation(PVector v) { swarm.x[index] = v.x; swarm.y[index] = v.y; }
+    void setVelocity(PVector v) { swarm.vx[index] = v.x; swarm.vy[index] = v.y; }
+
+    BoidSwarm::Params& params() { return swarm.params[index]; }
+    const BoidSwarm::Params& params() const { return swarm.params[index]; }
+
+    void applyForce(PVector force) { swarm.applyForce(index, force); }
+    void wrapAroundBorders(float width, float height) { swarm.wrapAroundBorders(index, width, height); }
+    void update(SpatialGrid& grid) { swarm.update(index, grid); }
+
+    Boid toBoid() const { return swarm.get(index); }
+
+private:
+    BoidSwarm& swarm;
+    uint16_t index;
+};
+
+#endif // BOID_SWARM_H
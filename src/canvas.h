@@ -5,6 +5,10 @@
 #include <FastLED.h>
 #include "config.h"
 #include "simd_utils.h"
+#include "fade_tables.h"
+#include "xy_map.h"
+#include "hdr_accumulator.h"
+#include "show_pipeline.h"
 
 // ---------------------------------------------------------------------------
 // Canvas: the shared pixel-placement layer.
@@ -16,95 +20,421 @@
 //
 // Coordinate system: physical display pixels, x in [0,width), y in [0,height),
 // origin at top-left.
+//
+// With CANVAS_LINEAR_FRAMEBUFFER the Canvas renders into its own row-major
+// framebuffer instead of the strip buffer, so xy() is just y * width + x and
+// rows are contiguous for every kernel. show() then scatters the frame into
+// the strip order once (one memcpy or reversed copy per row) before
+// FastLED.show(). raw() and xy() always describe the buffer effects draw
+// into, so code that goes through them works in both modes.
+//
+// With CANVAS_HDR, additive draws (drawPixelF, drawPointsF, blendPixel, and
+// through it the MatrixEffects overlays) go to a 16-bit HdrAccumulator
+// instead of saturating per draw. The light is resolved into the buffer
+// through the tone map before anything else reads or writes the buffer
+// directly (raw(), row(), fade(), show(), ...), so draw order is preserved
+// and TONEMAP_CLIP gives the same pixels as the 8-bit path.
+//
+// The Canvas also tracks which spans of the buffer (COLS consecutive LEDs of
+// raw() - one display row in row-wise layouts) may hold non-black pixels,
+// and whether anything changed since the last show(). fade() toward black
+// skips spans known to be black, and show() counts (or, with
+// CANVAS_SKIP_UNCHANGED_SHOW, skips) frames where nothing changed. Every
+// write path marks what it touches; raw() hands out unchecked access and so
+// marks the whole buffer.
+//
+// With SHOW_PIPELINE, show() copies the frame (in strip order) into a
+// ShowPipeline buffer and returns while another core transmits it; the
+// buffer effects draw into is never the one on the wire.
 // ---------------------------------------------------------------------------
 
-// Free function form of the XY mapping, suitable for APIs that take a plain
-// function pointer (e.g. MatrixEffects). Mirrors Canvas::xy().
+// Free function form of the strip XY mapping. The mapping itself is
+// generated at compile time from config.h (see xy_map.h).
 static inline uint16_t matrixXY(uint8_t x, uint8_t y) {
-    if (kMatrixFlipV) y = (ROWS - 1) - y;
-    if (kMatrixFlipH) x = (COLS - 1) - x;
-
-    uint16_t i;
-    if (kMatrixSerpentineLayout && (y & 0x01)) {
-        // Odd rows run backwards
-        uint8_t reverseX = (ROWS - 1) - x;
-        i = (y * ROWS) + reverseX;
-    } else {
-        i = (y * ROWS) + x;
-    }
-    return i;
+    return kXYTable.index[y][x];
 }
 
+// Free function form of Canvas::xy(), suitable for APIs that take a plain
+// function pointer and draw into canvas.raw().
+static inline uint16_t canvasXY(uint8_t x, uint8_t y) {
+    #if CANVAS_LINEAR_FRAMEBUFFER
+    return (uint16_t)y * COLS + x;
+    #else
+    return matrixXY(x, y);
+    #endif
+}
+
+// Skip FastLED.show() for frames in which nothing was drawn or faded.
+#ifndef CANVAS_SKIP_UNCHANGED_SHOW
+#define CANVAS_SKIP_UNCHANGED_SHOW 0
+#endif
+
+// Per-frame work counters, latched by Canvas::show().
+struct CanvasFrameStats {
+    uint32_t blackPixelsFaded = 0;  // already-black pixels fade() still processed
+    uint32_t pixelsFadeSkipped = 0; // pixels fade() skipped as known black
+    bool unchanged = false;         // nothing was drawn or faded this frame
+};
+
 class Canvas {
 public:
     const uint8_t width;
     const uint8_t height;
 
+    // Buffer spans tracked for blackness: SPANS spans of SPAN_LEN LEDs.
+    static const uint8_t SPAN_LEN = COLS;
+    static const uint8_t SPANS = ROWS;
+    static_assert(SPANS <= 32, "span mask is 32 bits");
+
+    #if CANVAS_LINEAR_FRAMEBUFFER
+    Canvas(CRGB* buffer, uint8_t width, uint8_t height)
+        : width(width), height(height), leds(frame), ledCount(width * height), strip(buffer) {}
+    #else
     Canvas(CRGB* buffer, uint8_t width, uint8_t height)
         : width(width), height(height), leds(buffer), ledCount(width * height) {}
+    #endif
 
     // --- Buffer access -----------------------------------------------------
-    CRGB* raw() { return leds; }
+    // The buffer effects draw into (the strip, or the linear framebuffer).
+    CRGB* raw() {
+        resolveHdr();
+        markAll();
+        return leds;
+    }
     int numLeds() const { return ledCount; }
 
-    // Map 2D coordinates to a strip index (serpentine aware).
-    uint16_t xy(uint8_t x, uint8_t y) const { return matrixXY(x, y); }
+    // Map 2D coordinates to an index into raw().
+    uint16_t xy(uint8_t x, uint8_t y) const { return canvasXY(x, y); }
 
     // --- Whole-buffer operations ------------------------------------------
-    void clear() { fill_solid(leds, ledCount, CRGB::Black); }
-    void fill(CRGB color) { fill_solid(leds, ledCount, color); }
+    void clear() {
+        discardHdr();
+        fill_solid(leds, ledCount, CRGB::Black);
+        litSpans = 0;
+        changed = true;
+    }
+    void fill(CRGB color) {
+        discardHdr();
+        fill_solid(leds, ledCount, color);
+        litSpans = (color.r | color.g | color.b) ? ALL_SPANS : 0;
+        changed = true;
+    }
 
-    // Fade the whole buffer toward a color using the SIMD-optimized routine.
+    // Fade the whole buffer toward a color. Same result as
+    // simd_fade_to_color(), done through a cached per-channel lookup table.
+    // Black stays black when fading toward black, so known-black spans are
+    // skipped. Each lit span is scanned once, before its fade: one found
+    // all black is dropped from the mask and skipped, so a span that fades
+    // out is dropped by the next fade().
     void fade(CRGB color, uint8_t amount) {
-        simd_fade_to_color(leds, ledCount, color, amount);
+        resolveHdr();
+        const bool toBlack = !(color.r | color.g | color.b);
+        if (!toBlack) markAll();
+        if (!litSpans) {
+            stats.pixelsFadeSkipped += ledCount;
+            return;
+        }
+
+        #if FADE_LUT_SLOTS
+        const FadeTable& table = fadeTables.get(color, amount, rran);
+        #endif
+        for (uint8_t s = 0; s < SPANS; s++) {
+            if (!(litSpans & (1u << s))) {
+                stats.pixelsFadeSkipped += SPAN_LEN;
+                continue;
+            }
+            CRGB* span = leds + (uint16_t)s * SPAN_LEN;
+            const uint8_t black = countBlack(span, SPAN_LEN);
+            if (toBlack && black == SPAN_LEN) {
+                litSpans &= ~(1u << s);
+                stats.pixelsFadeSkipped += SPAN_LEN;
+                continue;
+            }
+            #if DEBUG_SERIAL
+            stats.blackPixelsFaded += black;
+            #endif
+            #if FADE_LUT_SLOTS
+            table.apply(span, SPAN_LEN);
+            #else
+            simd_fade_to_color(span, SPAN_LEN, color, amount);
+            #endif
+        }
+        changed = true;
     }
 
     // Push the buffer to the LEDs.
-    void show() { FastLED.show(); }
+    void show() {
+        resolveHdr();
+        stats.unchanged = !changed;
+        lastStats = stats;
+        stats = CanvasFrameStats();
+        changed = false;
+        #if CANVAS_SKIP_UNCHANGED_SHOW
+        if (lastStats.unchanged) return;
+        #endif
+        #if SHOW_PIPELINE
+        CRGB* out = pipeline.acquire();
+        #if CANVAS_LINEAR_FRAMEBUFFER
+        present(out);
+        #else
+        memcpy(out, leds, ledCount * sizeof(CRGB));
+        #endif
+        pipeline.publish();
+        #else
+        #if CANVAS_LINEAR_FRAMEBUFFER
+        present(strip);
+        #endif
+        FastLED.show();
+        #endif
+    }
+
+    // Block until every frame passed to show() is on the LEDs (a no-op
+    // unless SHOW_PIPELINE transmits in the background).
+    void finishShow() {
+        #if SHOW_PIPELINE
+        pipeline.flush();
+        #endif
+    }
+
+    // --- Change tracking ----------------------------------------------------
+    // Bit s set: span s of raw() (LEDs [s * SPAN_LEN, (s + 1) * SPAN_LEN))
+    // may hold a non-black pixel. Clear bits are known black.
+    uint32_t litSpanMask() const { return litSpans; }
+    // Anything drawn or faded since the last show().
+    bool frameChanged() const { return changed; }
+    // Counters for the frame most recently presented by show().
+    const CanvasFrameStats& frameStats() const { return lastStats; }
+
+    // --- Row spans ----------------------------------------------------------
+    // A display row with its mapping resolved once, so span[x] needs no
+    // bounds check or coordinate mapping. Full-frame effects write through a
+    // RowSpan instead of paying setPixel()'s checks per pixel. x must be in
+    // [0, width), y in [0, height).
+    #if CANVAS_LINEAR_FRAMEBUFFER
+    // Linear framebuffer: a row is simply contiguous.
+    typedef CRGB* RowSpan;
+
+    RowSpan row(uint8_t y) {
+        resolveHdr();
+        markRow(y);
+        return &leds[(uint16_t)y * width];
+    }
+
+    // Copy a whole scanline (width pixels, left to right) into row y.
+    void writeRow(uint8_t y, const CRGB* src) {
+        resolveHdr();
+        markRow(y);
+        memcpy(&leds[(uint16_t)y * width], src, width * sizeof(CRGB));
+    }
+    #else
+    // Strip buffer: the row's slice of the XY table, one load per pixel.
+    struct RowSpan {
+        CRGB* leds;
+        const uint16_t* index;
+
+        CRGB& operator[](uint8_t x) const { return leds[index[x]]; }
+    };
+
+    RowSpan row(uint8_t y) {
+        resolveHdr();
+        markRow(y);
+        RowSpan span;
+        span.leds = leds;
+        span.index = kXYTable.index[y];
+        return span;
+    }
+
+    // Copy a whole scanline (width pixels, left to right) into row y.
+    void writeRow(uint8_t y, const CRGB* src) {
+        resolveHdr();
+        markRow(y);
+        writeStripRow(leds, y, src);
+    }
+    #endif
 
     // --- Single-pixel operations ------------------------------------------
-    CRGB getPixel(uint8_t x, uint8_t y) const { return leds[xy(x, y)]; }
+    CRGB getPixel(uint8_t x, uint8_t y) {
+        resolveHdr();
+        return leds[xy(x, y)];
+    }
 
     // Hard set a pixel (bounds-checked).
     void setPixel(int x, int y, CRGB color) {
         if (x < 0 || x >= width || y < 0 || y >= height) return;
-        leds[xy((uint8_t)x, (uint8_t)y)] = color;
+        resolveHdr();
+        const uint16_t i = xy((uint8_t)x, (uint8_t)y);
+        leds[i] = color;
+        mark(i);
     }
 
     // Additive blend a pixel (bounds-checked, saturating).
     void blendPixel(int x, int y, CRGB color) {
         if (x < 0 || x >= width || y < 0 || y >= height) return;
-        leds[xy((uint8_t)x, (uint8_t)y)] += color;
+        const uint16_t i = xy((uint8_t)x, (uint8_t)y);
+        #if CANVAS_HDR
+        hdr.add(i, color);
+        #else
+        leds[i] += color;
+        #endif
+        mark(i);
     }
 
     // Sub-pixel positioned draw using Wu's anti-aliasing algorithm.
     // Spreads the color across up to four neighboring pixels (additive).
     void drawPixelF(float fx, float fy, CRGB color) {
-        if (fx < 0 || fx >= width || fy < 0 || fy >= height) return;
-
-        uint8_t xx = (fx - (int)fx) * 255, yy = (fy - (int)fy) * 255;
-        uint8_t ix = 255 - xx, iy = 255 - yy;
-
-        #define CANVAS_WU_WEIGHT(a, b) ((uint8_t)(((a) * (b) + (a) + (b)) >> 8))
-        uint8_t wu[4] = {CANVAS_WU_WEIGHT(ix, iy), CANVAS_WU_WEIGHT(xx, iy),
-                         CANVAS_WU_WEIGHT(ix, yy), CANVAS_WU_WEIGHT(xx, yy)};
-        #undef CANVAS_WU_WEIGHT
-
-        for (uint8_t i = 0; i < 4; i++) {
-            int16_t xn = fx + (i & 1), yn = fy + ((i >> 1) & 1);
-            if (xn >= 0 && xn < width && yn >= 0 && yn < height) {
-                CRGB clr = getPixel(xn, yn);
-                clr.r = qadd8(clr.r, (color.r * wu[i]) >> 8);
-                clr.g = qadd8(clr.g, (color.g * wu[i]) >> 8);
-                clr.b = qadd8(clr.b, (color.b * wu[i]) >> 8);
-                setPixel(xn, yn, clr);
+        drawPointsF(&fx, &fy, &color, 1);
+    }
+
+    // Batched drawPixelF(): splat n points (xs[i], ys[i]) in colors[i].
+    // Each point is clipped once; interior points - all but the right column
+    // and bottom row - then accumulate into their four pixels with no further
+    // checks. Weights are integer Wu products of the 8-bit fractional
+    // offsets. Splats are saturating adds, so the order of points does not
+    // matter.
+    void drawPointsF(const float* xs, const float* ys, const CRGB* colors, uint16_t n) {
+        for (uint16_t k = 0; k < n; k++) {
+            const float fx = xs[k], fy = ys[k];
+            if (fx < 0 || fx >= width || fy < 0 || fy >= height) continue;
+
+            const int16_t x0 = (int16_t)fx, y0 = (int16_t)fy;
+            // fx + 1 is rounded in float, exactly as the neighbor always was.
+            const int16_t x1 = (int16_t)(fx + 1), y1 = (int16_t)(fy + 1);
+
+            uint8_t xx = (fx - x0) * 255, yy = (fy - y0) * 255;
+            uint8_t ix = 255 - xx, iy = 255 - yy;
+
+            #define CANVAS_WU_WEIGHT(a, b) ((uint8_t)(((a) * (b) + (a) + (b)) >> 8))
+            const uint8_t w00 = CANVAS_WU_WEIGHT(ix, iy), w10 = CANVAS_WU_WEIGHT(xx, iy);
+            const uint8_t w01 = CANVAS_WU_WEIGHT(ix, yy), w11 = CANVAS_WU_WEIGHT(xx, yy);
+            #undef CANVAS_WU_WEIGHT
+
+            const CRGB color = colors[k];
+            splat(xy(x0, y0), color, w00);
+            if (x1 < width && y1 < height) {
+                splat(xy(x1, y0), color, w10);
+                splat(xy(x0, y1), color, w01);
+                splat(xy(x1, y1), color, w11);
+            } else {
+                if (x1 < width) splat(xy(x1, y0), color, w10);
+                if (y1 < height) splat(xy(x0, y1), color, w01);
             }
         }
     }
 
+    // --- HDR accumulation (CANVAS_HDR) --------------------------------------
+    // Apply pending additive light now. Called implicitly by every direct
+    // buffer access; a no-op without CANVAS_HDR or when nothing is pending.
+    void resolveHdr() {
+        #if CANVAS_HDR
+        hdr.resolve(leds, ledCount);
+        #endif
+    }
+
+    #if CANVAS_HDR
+    void setToneMap(ToneMap mode) {
+        resolveHdr();
+        hdr.toneMap = mode;
+    }
+    ToneMap toneMap() const { return hdr.toneMap; }
+    const HdrAccumulator& hdrState() const { return hdr; }
+    #endif
+
 private:
+    static const uint32_t ALL_SPANS = SPANS == 32 ? 0xFFFFFFFFu : (1u << SPANS) - 1;
+
+    void mark(uint16_t i) {
+        litSpans |= 1u << (i / SPAN_LEN);
+        changed = true;
+    }
+    void markAll() {
+        litSpans = ALL_SPANS;
+        changed = true;
+    }
+    // Display row y. A row that is a contiguous run of the buffer touches
+    // at most the spans of its two ends; any other row may touch all of them.
+    void markRow(uint8_t y) {
+        #if CANVAS_LINEAR_FRAMEBUFFER
+        mark((uint16_t)y * width);
+        #else
+        if (kXYTable.rowStep[y]) {
+            mark(kXYTable.index[y][0]);
+            mark(kXYTable.index[y][width - 1]);
+        } else {
+            markAll();
+        }
+        #endif
+    }
+
+    static uint8_t countBlack(const CRGB* px, uint8_t n) {
+        uint8_t black = 0;
+        for (uint8_t i = 0; i < n; i++) black += !(px[i].r | px[i].g | px[i].b);
+        return black;
+    }
+
+    void splat(uint16_t i, CRGB color, uint8_t weight) {
+        mark(i);
+        #if CANVAS_HDR
+        hdr.add(i, color, weight);
+        #else
+        CRGB& px = leds[i];
+        px.r = qadd8(px.r, (color.r * weight) >> 8);
+        px.g = qadd8(px.g, (color.g * weight) >> 8);
+        px.b = qadd8(px.b, (color.b * weight) >> 8);
+        #endif
+    }
+
+    void discardHdr() {
+        #if CANVAS_HDR
+        hdr.discard();
+        #endif
+    }
+
+    // Copy a scanline into row y of a strip-ordered buffer: one memcpy when
+    // the row is a forward run of the strip, a reversed copy on backward
+    // serpentine rows, a per-pixel scatter otherwise.
+    void writeStripRow(CRGB* dst, uint8_t y, const CRGB* src) {
+        const uint16_t* index = kXYTable.index[y];
+        switch (kXYTable.rowStep[y]) {
+            case 1:
+                memcpy(&dst[index[0]], src, width * sizeof(CRGB));
+                break;
+            case -1: {
+                CRGB* base = &dst[index[0]];
+                for (uint8_t x = 0; x < width; x++) base[-(int)x] = src[x];
+                break;
+            }
+            default:
+                for (uint8_t x = 0; x < width; x++) dst[index[x]] = src[x];
+                break;
+        }
+    }
+
     CRGB* leds;
     int ledCount;
+    uint32_t litSpans = ALL_SPANS;
+    bool changed = true;
+    CanvasFrameStats stats;
+    CanvasFrameStats lastStats;
+    #if CANVAS_LINEAR_FRAMEBUFFER
+    // Scatter the row-major frame into strip order.
+    void present(CRGB* dst) {
+        for (uint8_t y = 0; y < height; y++) {
+            writeStripRow(dst, y, &frame[(uint16_t)y * width]);
+        }
+    }
+
+    CRGB* strip;
+    CRGB frame[ROWS * COLS];
+    #endif
+    #if FADE_LUT_SLOTS
+    FadeTableCache fadeTables;
+    #endif
+    #if SHOW_PIPELINE
+    ShowPipeline pipeline;
+    #endif
+    #if CANVAS_HDR
+    HdrAccumulator hdr;
+    #endif
 };
 
 #endif // CANVAS_H
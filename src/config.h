@@ -24,6 +24,24 @@ static const uint8_t ROWS = 24;
 static const uint8_t COLS = 24;
 static const bool kMatrixSerpentineLayout = true;
 
+// Strip wiring order (see xy_map.h). The default follows
+// kMatrixSerpentineLayout; pick another layout for differently wired panels.
+enum MatrixLayout : uint8_t {
+    LAYOUT_PROGRESSIVE = 0,   // every row left to right
+    LAYOUT_SERPENTINE,        // odd rows run right to left
+    LAYOUT_COLUMN_MAJOR,      // every column top to bottom
+    LAYOUT_COLUMN_SERPENTINE, // odd columns run bottom to top
+    LAYOUT_TILED              // kPanelWidth x kPanelHeight panels, chained row by row
+};
+static const MatrixLayout kMatrixLayout =
+    kMatrixSerpentineLayout ? LAYOUT_SERPENTINE : LAYOUT_PROGRESSIVE;
+
+// LAYOUT_TILED only: size of one panel (must divide COLS / ROWS) and whether
+// the rows inside each panel are serpentine.
+static const uint8_t kPanelWidth = 8;
+static const uint8_t kPanelHeight = 8;
+static const bool kPanelSerpentine = true;
+
 // Orientation flips (applied in matrixXY, so ALL effects flip consistently).
 // Set kMatrixFlipV = true if the display is mounted upside-down (y=0 should be
 // the physical top). Set kMatrixFlipH = true to mirror left/right.
@@ -32,8 +50,37 @@ static const bool kMatrixFlipH = false;
 
 #define NUM_LEDS (ROWS * COLS)
 
+// Render into a row-major framebuffer owned by the Canvas and scatter it into
+// strip order once per frame at show() (1.7 KB extra RAM, one copy per
+// frame). Off: effects draw straight into the strip buffer.
+#ifndef CANVAS_LINEAR_FRAMEBUFFER
+#define CANVAS_LINEAR_FRAMEBUFFER 0
+#endif
+
+// Accumulate additive draws (Wu splats, blendPixel) in 16 bits per channel
+// and tone-map them into the frame once (3.4 KB extra RAM, see
+// hdr_accumulator.h). Off: every additive draw saturates at 8 bits.
+#ifndef CANVAS_HDR
+#define CANVAS_HDR 0
+#endif
+
+// Transmit frames from a task on the other core while the next frame renders
+// (two 1.7 KB strip buffers, see show_pipeline.h). Off: show() blocks for the
+// whole transmission.
+#ifndef SHOW_PIPELINE
+#define SHOW_PIPELINE 0
+#endif
+
 // --- Diagnostics ---
 // Set to false to strip serial logging from the build.
 #define DEBUG_SERIAL true
 
+// Count C++ heap allocations (global operator new/delete, see heap_counter.h)
+// and have the EffectManager log allocations per frame. Debug builds only:
+// off by default so normal firmware keeps the stock allocator; build with
+// -DDEBUG_HEAP_COUNTER=1 to enable.
+#ifndef DEBUG_HEAP_COUNTER
+#define DEBUG_HEAP_COUNTER 0
+#endif
+
 #endif // CONFIG_H
@@ -0,0 +1,127 @@
+#ifndef CORE_WORKER_H
+#define CORE_WORKER_H
+
+#include <Arduino.h>
+#include <atomic>
+
+#if !defined(ESP32)
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+// ---------------------------------------------------------------------------
+// CoreWorker: run one job at a time on the other core.
+//
+// dispatch() hands a job to the worker - a FreeRTOS task pinned to `core`,
+// or a std::thread on a host build - and returns immediately; wait() is the
+// barrier that returns once the job has finished. The worker starts on the
+// first dispatch(). One caller task at a time.
+// ---------------------------------------------------------------------------
+class CoreWorker {
+public:
+    typedef void (*Job)(void* arg);
+
+    explicit CoreWorker(uint8_t core = 0, uint8_t priority = 2) : core(core), priority(priority) {}
+    ~CoreWorker() { end(); }
+
+    // Run job(arg) on the worker. The previous job must have been waited for.
+    void dispatch(Job fn, void* fnArg) {
+        if (!started) begin();
+        #if defined(ESP32)
+        callerTask = xTaskGetCurrentTaskHandle();
+        #endif
+        job = fn;
+        arg = fnArg;
+        pending.store(true, std::memory_order_release);
+        wakeWorker();
+    }
+
+    // Barrier: block until the dispatched job has finished.
+    void wait() {
+        while (pending.load(std::memory_order_acquire)) waitForWorker();
+    }
+
+private:
+    void begin() {
+        started = true;
+        #if defined(ESP32)
+        xTaskCreatePinnedToCore(workerEntry, "core_worker", 4096, this, priority, &workerTask, core);
+        #else
+        worker = std::thread(&CoreWorker::workerLoop, this);
+        #endif
+    }
+
+    // The worker task lives as long as the program on the board; a host
+    // build stops and joins it at exit.
+    void end() {
+        #if !defined(ESP32)
+        if (!started) return;
+        wait();
+        stopping.store(true, std::memory_order_release);
+        wakeWorker();
+        worker.join();
+        started = false;
+        #endif
+    }
+
+    void workerLoop() {
+        for (;;) {
+            if (!pending.load(std::memory_order_acquire)) {
+                if (stopping.load(std::memory_order_acquire)) return;
+                sleepWorker();
+                continue;
+            }
+            job(arg);
+            pending.store(false, std::memory_order_release);
+            wakeCaller();
+        }
+    }
+
+    // Wake-ups: latching task notifications on the board; latching flags
+    // under a mutex and condition variable on the host.
+    #if defined(ESP32)
+    static void workerEntry(void* self) { static_cast<CoreWorker*>(self)->workerLoop(); }
+    void wakeWorker() { xTaskNotifyGive(workerTask); }
+    void sleepWorker() { ulTaskNotifyTake(pdTRUE, portMAX_DELAY); }
+    void wakeCaller() { xTaskNotifyGive(callerTask); }
+    void waitForWorker() { ulTaskNotifyTake(pdTRUE, portMAX_DELAY); }
+
+    TaskHandle_t workerTask = nullptr;
+    TaskHandle_t callerTask = nullptr;
+    #else
+    void wakeWorker() { notify(workerNote); }
+    void sleepWorker() { take(workerNote); }
+    void wakeCaller() { notify(callerNote); }
+    void waitForWorker() { take(callerNote); }
+
+    void notify(bool& note) {
+        {
+            std::lock_guard<std::mutex> lock(noteLock);
+            note = true;
+        }
+        noteCond.notify_all();
+    }
+    void take(bool& note) {
+        std::unique_lock<std::mutex> lock(noteLock);
+        noteCond.wait(lock, [&note] { return note; });
+        note = false;
+    }
+
+    std::thread worker;
+    std::mutex noteLock;
+    std::condition_variable noteCond;
+    bool workerNote = false;
+    bool callerNote = false;
+    #endif
+
+    const uint8_t core;
+    const uint8_t priority;
+    Job job = nullptr;
+    void* arg = nullptr;
+    std::atomic<bool> pending{false};
+    std::atomic<bool> stopping{false};
+    bool started = false;
+};
+
+#endif // CORE_WORKER_H
@@ -0,0 +1,227 @@
+#ifndef EFFECT_BENCH_H
+#define EFFECT_BENCH_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include <algorithm>
+#include "effect.h"
+#include "effect_manager.h"
+
+// ---------------------------------------------------------------------------
+// EffectBench: per-effect frame-time benchmark.
+//
+// Drives one effect through enter() + N update() calls against the shared
+// Canvas and reports min / median / p99 / max microseconds per update and the
+// median cost per display pixel. Every run starts from the same state: the
+// canvas is cleared, random()/random8() are reseeded, and update() always gets
+// the same dtMs. Only update() is timed; show() (the strip transfer) is not
+// called at all, so the numbers are pure render cost.
+//
+// The harness is shared by the firmware (serial command, see main.cpp) and
+// the host build (host/bench_main.cpp) so both produce the same rows:
+//
+//   clock        timing source; nullptr means micros(). The host passes a
+//                wall clock, since its micros() follows the virtual clock.
+//   advanceClock optional hook called with dtMs after every frame. The host
+//                uses it to step the virtual clock so effects reading millis()
+//                see exactly dtMs per frame; on the board time just runs.
+//
+// Results print as CSV or JSON through any Serial-like object (print/println),
+// one row per effect, so runs can be saved and diffed across commits.
+// ---------------------------------------------------------------------------
+
+struct EffectBenchResult {
+    const char* name;
+    uint16_t frames;
+    uint32_t minUs;
+    uint32_t medianUs;
+    uint32_t p99Us;
+    uint32_t maxUs;
+    float meanUs;
+    float nsPerPixel;  // median update time / display pixels
+};
+
+enum EffectBenchFormat : uint8_t {
+    BENCH_CSV = 0,
+    BENCH_JSON
+};
+
+class EffectBench {
+public:
+    static const uint16_t MAX_FRAMES = 512;
+
+    typedef uint32_t (*ClockFn)();
+    typedef void (*AdvanceFn)(uint32_t dtMs);
+
+    EffectBench(EffectContext& ctx, ClockFn clock = nullptr, AdvanceFn advanceClock = nullptr)
+        : ctx(ctx), clock(clock), advanceClock(advanceClock) {}
+
+    uint16_t frames = 300;   // timed updates per effect (capped at MAX_FRAMES)
+    uint16_t warmup = 30;    // untimed updates after enter()
+    uint32_t seed = 1;
+    uint32_t dtMs = 16;      // fixed frame step handed to update()
+
+    // Benchmark a single effect.
+    EffectBenchResult run(Effect& effect) {
+        const uint16_t n = timedFrames();
+
+        randomSeed(seed);
+        random16_set_seed((uint16_t)seed);
+        ctx.canvas.clear();
+        effect.enter(ctx);
+
+        for (uint16_t f = 0; f < warmup; f++) {
+            effect.update(ctx, dtMs);
+            if (advanceClock) advanceClock(dtMs);
+        }
+
+        uint64_t total = 0;
+        for (uint16_t f = 0; f < n; f++) {
+            uint32_t start = now();
+            effect.update(ctx, dtMs);
+            samples[f] = now() - start;
+            total += samples[f];
+            if (advanceClock) advanceClock(dtMs);
+        }
+
+        effect.exit(ctx);
+
+        EffectBenchResult r;
+        r.name = effect.name();
+        r.frames = n;
+        if (n == 0) {
+            r.minUs = r.medianUs = r.p99Us = r.maxUs = 0;
+            r.meanUs = r.nsPerPixel = 0;
+            return r;
+        }
+
+        std::sort(samples, samples + n);
+        r.minUs = samples[0];
+        r.medianUs = samples[n / 2];
+        r.p99Us = samples[(n * 99 + 99) / 100 - 1]; // nearest rank
+        r.maxUs = samples[n - 1];
+        r.meanUs = (float)total / n;
+        r.nsPerPixel = r.medianUs * 1000.0F / ctx.canvas.numLeds();
+        return r;
+    }
+
+    // Benchmark every effect registered with the manager (optionally only the
+    // ones whose name contains `filter`), storing up to maxResults rows in
+    // results. Returns the number of rows. The active effect is exited first
+    // and the manager restarted afterwards, so this can be triggered from a
+    // running loop.
+    uint8_t runAll(EffectManager& manager, EffectBenchResult* results, uint8_t maxResults,
+                   const char* filter = nullptr) {
+        Effect* active = manager.activeEffect();
+        if (active) active->exit(ctx);
+
+        uint8_t n = 0;
+        for (uint8_t i = 0; i < manager.effectCount() && n < maxResults; i++) {
+            Effect* effect = manager.effectAt(i);
+            if (filter && !strstr(effect->name(), filter)) continue;
+            results[n++] = run(*effect);
+        }
+
+        if (active) {
+            ctx.canvas.clear();
+            manager.restart();
+        }
+        return n;
+    }
+
+    // Print rows from runAll() as one CSV / JSON report. Format the same
+    // result set several times to get matching reports from a single run.
+    template <typename Out>
+    void printReport(Out& out, EffectBenchFormat format, const EffectBenchResult* results,
+                     uint8_t n) const {
+        printHeader(out, format);
+        for (uint8_t i = 0; i < n; i++) printRow(out, format, results[i], i == 0);
+        printFooter(out, format);
+    }
+
+    // runAll() and print the report.
+    template <typename Out>
+    void runSuite(EffectManager& manager, Out& out, EffectBenchFormat format = BENCH_CSV,
+                  const char* filter = nullptr) {
+        EffectBenchResult results[EffectManager::MAX_EFFECTS];
+        printReport(out, format, results, runAll(manager, results, EffectManager::MAX_EFFECTS, filter));
+    }
+
+    template <typename Out>
+    void printHeader(Out& out, EffectBenchFormat format) const {
+        if (format == BENCH_JSON) {
+            out.print("{\"pixels\":");
+            out.print(ctx.canvas.numLeds());
+            out.print(",\"frames\":");
+            out.print((unsigned int)timedFrames());
+            out.print(",\"warmup\":");
+            out.print((unsigned int)warmup);
+            out.print(",\"seed\":");
+            out.print((unsigned long)seed);
+            out.print(",\"dt_ms\":");
+            out.print((unsigned long)dtMs);
+            out.println(",\"effects\":[");
+        } else {
+            out.println("effect,frames,min_us,median_us,p99_us,max_us,mean_us,ns_per_px");
+        }
+    }
+
+    template <typename Out>
+    void printRow(Out& out, EffectBenchFormat format, const EffectBenchResult& r, bool first) const {
+        if (format == BENCH_JSON) {
+            if (!first) out.println(",");
+            out.print("  {\"effect\":\"");
+            out.print(r.name);
+            out.print("\",\"frames\":");
+            out.print((unsigned int)r.frames);
+            out.print(",\"min_us\":");
+            out.print((unsigned long)r.minUs);
+            out.print(",\"median_us\":");
+            out.print((unsigned long)r.medianUs);
+            out.print(",\"p99_us\":");
+            out.print((unsigned long)r.p99Us);
+            out.print(",\"max_us\":");
+            out.print((unsigned long)r.maxUs);
+            out.print(",\"mean_us\":");
+            out.print(r.meanUs, 1);
+            out.print(",\"ns_per_px\":");
+            out.print(r.nsPerPixel, 1);
+            out.print("}");
+        } else {
+            out.print(r.name);
+            out.print(",");
+            out.print((unsigned int)r.frames);
+            out.print(",");
+            out.print((unsigned long)r.minUs);
+            out.print(",");
+            out.print((unsigned long)r.medianUs);
+            out.print(",");
+            out.print((unsigned long)r.p99Us);
+            out.print(",");
+            out.print((unsigned long)r.maxUs);
+            out.print(",");
+            out.print(r.meanUs, 1);
+            out.print(",");
+            out.println(r.nsPerPixel, 1);
+        }
+    }
+
+    template <typename Out>
+    void printFooter(Out& out, EffectBenchFormat format) const {
+        if (format == BENCH_JSON) {
+            out.println();
+            out.println("]}");
+        }
+    }
+
+private:
+    uint16_t timedFrames() const { return frames < MAX_FRAMES ? frames : MAX_FRAMES; }
+    uint32_t now() const { return clock ? clock() : (uint32_t)micros(); }
+
+    EffectContext& ctx;
+    ClockFn clock;
+    AdvanceFn advanceClock;
+    uint32_t samples[MAX_FRAMES];
+};
+
+#endif // EFFECT_BENCH_H
@@ -3,6 +3,30 @@
 
 #include <Arduino.h>
 #include "effect.h"
+#include "heap_counter.h"
+
+// Target frame rate of the fixed-timestep scheduler. 0 = free-running: one
+// update per loop() with the measured dt (the original behavior).
+#ifndef EFFECT_TARGET_FPS
+#define EFFECT_TARGET_FPS 0
+#endif
+
+// Most simulation steps one frame may run to catch up after a slow frame;
+// time beyond that is dropped so a heavy effect slows down instead of
+// spiraling.
+#ifndef EFFECT_MAX_CATCHUP_STEPS
+#define EFFECT_MAX_CATCHUP_STEPS 4
+#endif
+
+// Per-frame scheduler timing, see EffectManager::lastFrameTiming().
+struct FrameTiming {
+    uint32_t catchUpUs = 0;   // extra update() steps run to catch up
+    uint32_t updateUs = 0;    // the update() that rendered the shown frame
+    uint32_t showUs = 0;      // canvas.show()
+    uint32_t idleUs = 0;      // time slept to hold the target rate
+    uint8_t steps = 0;        // update() calls this frame
+    uint8_t droppedSteps = 0; // steps skipped beyond EFFECT_MAX_CATCHUP_STEPS
+};
 
 // ---------------------------------------------------------------------------
 // EffectManager
@@ -11,9 +35,32 @@
 // owns presentation: after the active effect renders, the manager calls
 // canvas.show() exactly once per frame.
 //
+// Frame pacing: with a target FPS set (EFFECT_TARGET_FPS / setTargetFps()),
+// update() runs a fixed-timestep loop. It sleeps out the rest of the frame
+// period when the previous frame finished early (so light effects leave the
+// CPU idle), then calls the effect's update() once per elapsed step with the
+// step's dt - effects advance by a fixed amount per call, so this keeps
+// their speed independent of render and show time. dt is in whole
+// milliseconds with the remainder carried, so it sums to the step time.
+// After a slow frame it runs up to EFFECT_MAX_CATCHUP_STEPS steps and drops
+// the rest. Effects simulate and render in the same update(), so catch-up
+// steps render too; only the last one is shown.
+//
+// With SHOW_PIPELINE (see show_pipeline.h) canvas.show() only hands the frame
+// to the LED sender on the other core, so the next update() overlaps the
+// transmission and FrameTiming::showUs is the handoff, not the wire time.
+//
 // Auto-rotation is opt-in: if the active effect reports a non-zero
 // suggestedDurationMs(), the manager advances to the next registered effect
 // after that time. With a single registered effect, behavior is "run forever".
+//
+// With DEBUG_HEAP_COUNTER on, the manager also counts heap allocations made
+// during update + show and logs the per-frame average every few seconds, so a
+// non-zero value in the steady-state frame loop shows up immediately.
+//
+// With DEBUG_SERIAL it likewise logs the Canvas change-tracking counters:
+// already-black pixels fade() still processed, pixels it skipped, and frames
+// in which nothing changed.
 // ---------------------------------------------------------------------------
 
 class EffectManager {
@@ -33,8 +80,16 @@ public:
     void begin(int startIndex = 0) {
         if (count == 0) return;
         activeIndex = constrain(startIndex, 0, count - 1);
+        setTargetFps(EFFECT_TARGET_FPS);
         lastUpdateMs = millis();
         effectStartMs = lastUpdateMs;
+        #if DEBUG_HEAP_COUNTER
+        heapLogMs = lastUpdateMs;
+        #endif
+        #if DEBUG_SERIAL
+        canvasLogMs = lastUpdateMs;
+        frameLogMs = lastUpdateMs;
+        #endif
         effects[activeIndex]->enter(ctx);
         logActive();
     }
@@ -43,12 +98,41 @@ public:
     void update() {
         if (count == 0) return;
 
+        FrameTiming t;
+        t.steps = 1;
+        if (stepUs) {
+            t.idleUs = waitForStep();
+            t.steps = takeSteps(t.droppedSteps);
+        }
+
         uint32_t now = millis();
-        uint32_t dt = now - lastUpdateMs;
+        uint32_t freeDt = now - lastUpdateMs;
         lastUpdateMs = now;
 
-        effects[activeIndex]->update(ctx, dt);
+        #if DEBUG_HEAP_COUNTER
+        uint32_t allocsBefore = heapAllocCount();
+        #endif
+
+        uint32_t mark = micros();
+        for (uint8_t i = 1; i < t.steps; i++) {
+            effects[activeIndex]->update(ctx, stepDtMs());
+        }
+        uint32_t updateStart = micros();
+        t.catchUpUs = updateStart - mark;
+        effects[activeIndex]->update(ctx, stepUs ? stepDtMs() : freeDt);
+        uint32_t showStart = micros();
+        t.updateUs = showStart - updateStart;
         ctx.canvas.show();
+        t.showUs = micros() - showStart;
+        timing = t;
+
+        #if DEBUG_HEAP_COUNTER
+        logHeapAllocs(heapAllocCount() - allocsBefore, now);
+        #endif
+        #if DEBUG_SERIAL
+        logCanvasStats(now);
+        logFrameTiming(now);
+        #endif
 
         uint32_t duration = effects[activeIndex]->suggestedDurationMs();
         if (duration > 0 && (now - effectStartMs) >= duration) {
@@ -66,17 +150,93 @@ public:
         activeIndex = index;
         effectStartMs = millis();
         effects[activeIndex]->enter(ctx);
+        restartClock();
         logActive();
     }
 
     // Advance to the next effect (wraps around).
     void next() { setActive((activeIndex + 1) % count); }
 
+    // enter() the active effect again after something ran outside update()
+    // (the benchmark suite) and exit()ed it, restarting its rotation timer
+    // and the frame clock so the time spent is neither caught up on nor
+    // counted as one long frame.
+    void restart() {
+        if (count == 0) return;
+        lastUpdateMs = millis();
+        effectStartMs = lastUpdateMs;
+        effects[activeIndex]->enter(ctx);
+        restartClock();
+    }
+
     int activeEffectIndex() const { return activeIndex; }
     uint8_t effectCount() const { return count; }
     Effect* activeEffect() { return count ? effects[activeIndex] : nullptr; }
+    Effect* effectAt(uint8_t index) { return index < count ? effects[index] : nullptr; }
+
+    // --- Frame pacing -------------------------------------------------------
+    // 0 = free-running.
+    void setTargetFps(uint16_t fps) {
+        targetFpsValue = fps;
+        stepUs = fps ? 1000000UL / fps : 0;
+        restartClock();
+    }
+    uint16_t targetFps() const { return targetFpsValue; }
+
+    // Timing of the most recent frame.
+    const FrameTiming& lastFrameTiming() const { return timing; }
 
 private:
+    // Start the step clock afresh, e.g. after a slow enter(), so it is not
+    // caught up on.
+    void restartClock() {
+        lastStepUs = micros();
+        lagUs = 0;
+        dtCarryUs = 0;
+    }
+
+    // dt in whole milliseconds for one fixed step. The sub-millisecond rest
+    // carries into the next step, so at 60 fps the steps hand out a mix of
+    // 16 and 17 ms that sums to the real step time.
+    uint32_t stepDtMs() {
+        dtCarryUs += stepUs;
+        uint32_t ms = dtCarryUs / 1000;
+        dtCarryUs -= ms * 1000;
+        return ms;
+    }
+
+    // Sleep until at least one step period has passed since the last frame.
+    // Whole milliseconds go through delay() so the RTOS idle task runs.
+    uint32_t waitForStep() {
+        uint32_t elapsed = micros() - lastStepUs;
+        if (lagUs + elapsed >= stepUs) return 0;
+        uint32_t idle = stepUs - lagUs - elapsed;
+        if (idle >= 1000) delay(idle / 1000);
+        if (idle % 1000) delayMicroseconds(idle % 1000);
+        return idle;
+    }
+
+    // Consume the elapsed time in whole steps, capped at the catch-up limit.
+    uint8_t takeSteps(uint8_t& dropped) {
+        uint32_t now = micros();
+        lagUs += now - lastStepUs;
+        lastStepUs = now;
+
+        uint32_t steps = lagUs / stepUs;
+        lagUs -= steps * stepUs;
+        if (steps == 0) {
+            // Woke early (delay granularity): take the step, start over.
+            steps = 1;
+            lagUs = 0;
+        }
+        dropped = 0;
+        if (steps > EFFECT_MAX_CATCHUP_STEPS) {
+            dropped = (uint8_t)min(steps - EFFECT_MAX_CATCHUP_STEPS, (uint32_t)255);
+            steps = EFFECT_MAX_CATCHUP_STEPS;
+        }
+        return (uint8_t)steps;
+    }
+
     void logActive() {
         #if DEBUG_SERIAL
         Serial.print("[EFFECT] Active: ");
@@ -84,12 +244,124 @@ private:
         #endif
     }
 
+    #if DEBUG_HEAP_COUNTER
+    void logHeapAllocs(uint32_t frameAllocs, uint32_t now) {
+        heapFrameAllocs += frameAllocs;
+        heapFrames++;
+        if (now - heapLogMs < HEAP_LOG_INTERVAL_MS) return;
+
+        #if DEBUG_SERIAL
+        Serial.print("[HEAP] ");
+        Serial.print(effects[activeIndex]->name());
+        Serial.print(": ");
+        Serial.print(heapFrameAllocs);
+        Serial.print(" allocs in ");
+        Serial.print(heapFrames);
+        Serial.print(" frames (");
+        Serial.print((float)heapFrameAllocs / heapFrames, 2);
+        Serial.println("/frame)");
+        #endif
+
+        heapFrameAllocs = 0;
+        heapFrames = 0;
+        heapLogMs = now;
+    }
+
+    static const uint32_t HEAP_LOG_INTERVAL_MS = 5000;
+    uint32_t heapFrameAllocs = 0;
+    uint32_t heapFrames = 0;
+    uint32_t heapLogMs = 0;
+    #endif
+
+    #if DEBUG_SERIAL
+    void logCanvasStats(uint32_t now) {
+        const CanvasFrameStats& s = ctx.canvas.frameStats();
+        canvasBlackFaded += s.blackPixelsFaded;
+        canvasFadeSkipped += s.pixelsFadeSkipped;
+        canvasUnchanged += s.unchanged;
+        canvasFrames++;
+        if (now - canvasLogMs < STATS_LOG_INTERVAL_MS) return;
+
+        Serial.print("[CANVAS] ");
+        Serial.print(effects[activeIndex]->name());
+        Serial.print(": ");
+        Serial.print((float)canvasBlackFaded / canvasFrames, 1);
+        Serial.print(" black px faded/frame, ");
+        Serial.print((float)canvasFadeSkipped / canvasFrames, 1);
+        Serial.print(" px skipped/frame, ");
+        Serial.print(canvasUnchanged);
+        Serial.print(" of ");
+        Serial.print(canvasFrames);
+        Serial.println(" frames unchanged");
+
+        canvasBlackFaded = 0;
+        canvasFadeSkipped = 0;
+        canvasUnchanged = 0;
+        canvasFrames = 0;
+        canvasLogMs = now;
+    }
+
+    void logFrameTiming(uint32_t now) {
+        frameLogFrames++;
+        frameLogSteps += timing.steps;
+        frameLogDropped += timing.droppedSteps;
+        frameLogUpdateUs += timing.catchUpUs + timing.updateUs;
+        frameLogShowUs += timing.showUs;
+        frameLogIdleUs += timing.idleUs;
+        if (now - frameLogMs < STATS_LOG_INTERVAL_MS) return;
+
+        const float frames = frameLogFrames;
+        Serial.print("[FRAME] ");
+        Serial.print(frameLogFrames * 1000.0f / (now - frameLogMs), 1);
+        Serial.print(" fps, update ");
+        Serial.print(frameLogUpdateUs / frames, 0);
+        Serial.print(" us, show ");
+        Serial.print(frameLogShowUs / frames, 0);
+        Serial.print(" us, idle ");
+        Serial.print(frameLogIdleUs / frames, 0);
+        Serial.print(" us, ");
+        Serial.print(frameLogSteps - frameLogFrames);
+        Serial.print(" catch-up / ");
+        Serial.print(frameLogDropped);
+        Serial.println(" dropped steps");
+
+        frameLogFrames = 0;
+        frameLogSteps = 0;
+        frameLogDropped = 0;
+        frameLogUpdateUs = 0;
+        frameLogShowUs = 0;
+        frameLogIdleUs = 0;
+        frameLogMs = now;
+    }
+
+    static const uint32_t STATS_LOG_INTERVAL_MS = 5000;
+    uint32_t canvasBlackFaded = 0;
+    uint32_t canvasFadeSkipped = 0;
+    uint32_t canvasUnchanged = 0;
+    uint32_t canvasFrames = 0;
+    uint32_t canvasLogMs = 0;
+    uint32_t frameLogFrames = 0;
+    uint32_t frameLogSteps = 0;
+    uint32_t frameLogDropped = 0;
+    uint32_t frameLogUpdateUs = 0;
+    uint32_t frameLogShowUs = 0;
+    uint32_t frameLogIdleUs = 0;
+    uint32_t frameLogMs = 0;
+    #endif
+
     EffectContext& ctx;
     Effect* effects[MAX_EFFECTS] = {nullptr};
     uint8_t count = 0;
     int activeIndex = 0;
     uint32_t lastUpdateMs = 0;
     uint32_t effectStartMs = 0;
+
+    uint16_t targetFpsValue = 0;
+    uint32_t stepUs = 0;      // fixed step, 0 when free-running
+    uint32_t lastStepUs = 0;
+    uint32_t lagUs = 0;       // elapsed time not yet consumed by steps
+    uint32_t dtCarryUs = 0;   // step time not yet handed out as dt
+    FrameTiming timing;
 };
 
 #endif // EFFECT_MANAGER_H
@@ -29,12 +29,13 @@ public:
     void update(EffectContext& ctx, uint32_t) override {
         Canvas& c = ctx.canvas;
         for (uint8_t y = 0; y < c.height; y++) {
+            Canvas::RowSpan row = c.row(y);
             for (uint8_t x = 0; x < c.width; x++) {
                 uint8_t bri = inoise8(x * 38, y * 42 - t);
                 uint8_t idx = inoise8(x * 30 + 1000, y * 22 - (t >> 1));
                 // Fade the bottom rows so curtains hang from the top.
                 uint8_t vfade = scale8(bri, 120 + (y * 135 / c.height));
-                c.setPixel(x, y, ColorFromPalette(pal, idx, vfade, LINEARBLEND));
+                row[x] = ColorFromPalette(pal, idx, vfade, LINEARBLEND);
             }
         }
         t += 9;
@@ -7,7 +7,10 @@
 #include "../vec2.h"
 #include "../spatial_grid.h" // must precede boid.h
 #include "../boid.h"
+#include "../boid_swarm.h"
 #include "../attractor.h"
+#include "../attractor_field.h"
+#include "../attractor_grid.h"
 #include "../canvas.h"
 #include "../palettes.h"
 #include "../effect.h"
@@ -19,6 +22,14 @@ extern int rran;
 extern int gran;
 extern int bran;
 
+// Attractor patterns that use the rasterized force grid (AttractorForceGrid)
+// instead of the exact per-boid field: bit N enables pattern N. Off by
+// default; toggle per pattern at runtime with 'g' on the serial interface.
+// Ignored in BOID_PHYSICS_FIXED builds (the grid is float).
+#ifndef ATTRACTOR_GRID_PATTERNS
+#define ATTRACTOR_GRID_PATTERNS 0
+#endif
+
 // ---------------------------------------------------------------------------
 // BoidsEffect: flocking particles driven by a rotating cast of gravitational
 // attractors, with periodic "move to center", slow-down/pause, explosion and
@@ -36,6 +47,29 @@ public:
     // Run for 30s before the manager rotates to the next effect.
     uint32_t suggestedDurationMs() const override { return 30000; }
 
+    // Switch the current attractor pattern between the exact field and the
+    // rasterized force grid; the serial debug interface binds this to 'g'.
+    void toggleAttractorGridForPattern() {
+        attractorGridPatterns ^= (uint16_t)(1u << currentAttractorPattern);
+        #if DEBUG_SERIAL
+        Serial.print("[ATTRACTOR GRID] pattern ");
+        Serial.print(currentAttractorPattern);
+        Serial.println(attractorGridActive() ? ": grid" : ": exact");
+        #endif
+    }
+
+    // Cycle the flocking backend (three-pass <-> fused) for on-device A/B
+    // timing; the serial debug interface in main.cpp binds this to 'b'.
+    void nextFlockingBackend() {
+        swarm.backend = (swarm.backend == BoidSwarm::FLOCKING_FUSED)
+                            ? BoidSwarm::FLOCKING_THREE_PASS
+                            : BoidSwarm::FLOCKING_FUSED;
+        #if DEBUG_SERIAL
+        Serial.print("[BOIDS] Flocking backend: ");
+        Serial.println(BoidSwarm::backendName(swarm.backend));
+        #endif
+    }
+
     void enter(EffectContext& ctx) override {
         if (!spatialGrid) {
             spatialGrid = new SpatialGrid(GRID_CELLS_X, GRID_CELLS_Y, VIRTUAL_ROWS, VIRTUAL_COLS);
@@ -93,11 +127,7 @@ public:
         ctx.overlay.getShakeOffsets(shakeOffsetX, shakeOffsetY);
 
         // Repopulate the spatial grid for this frame.
-        spatialGrid->clear();
-        for (int i = 0; i < count; i++) {
-            Boid* boid = &boids[i];
-            spatialGrid->insert(boid, boid->location.x, boid->location.y);
-        }
+        swarm.populateGrid(*spatialGrid, count);
 
         updateAttractors(ctx);
 
@@ -117,7 +147,7 @@ public:
         } else {
             // Original path (must stay pixel-identical when feedback is OFF):
             // apply overlay FX, then fade.
-            ctx.overlay.update(ctx.canvas.raw());
+            ctx.overlay.update(ctx.canvas);
             ctx.canvas.fade(CRGB::Black, 45);
         }
 
@@ -160,68 +190,126 @@ public:
             ctx.overlay.startRipple();
         }
 
-        // Update + render boids.
-        for (int i = 0; i < count; i++) {
-            Boid* boid = &boids[i];
-
-            // Apply forces from all active attractors.
-            for (int j = 0; j < MAX_ATTRACTORS; j++) {
-                if (attractorActive[j]) {
-                    PVector force = attractorArray[j]->attract(*boid);
-                    boid->applyForce(force);
-                }
+        // Forces from all active attractors (plus the explosion repulsor) for
+        // the whole flock in one batched pass.
+        attractorField.clear();
+        for (int j = 0; j < MAX_ATTRACTORS; j++) {
+            if (attractorActive[j]) {
+                attractorField.add(*attractorArray[j]);
             }
+        }
+        if (explosionActive) {
+            attractorField.add(explosionRepulsor);
+        }
+        if (attractorGridActive()) {
+            attractorGrid.rasterize(attractorField);
+            attractorGrid.apply(swarm, count);
+        } else {
+            attractorField.apply(swarm, count);
+        }
 
-            // Apply explosion repulsor force if active.
-            if (explosionActive) {
-                PVector explosionForce = explosionRepulsor.attract(*boid);
-                boid->applyForce(explosionForce);
-            }
+        // Update + render boids.
+        for (int i = 0; i < count; i++) {
+            BoidSwarm::Params& p = swarm.params[i];
 
-            boid->wrapAroundBorders(VIRTUAL_ROWS, VIRTUAL_COLS);
-            boid->brightness = map(boid->velocity.x + boid->velocity.y, 0.1, 4.5, 25, 255);
-            boid->mass = (255 - count) / 6;
-            boid->update(*spatialGrid);
+            swarm.wrapAroundBorders(i, VIRTUAL_ROWS, VIRTUAL_COLS);
+            p.brightness = map(swarm.vx[i] + swarm.vy[i], 0.1, 4.5, 25, 255);
+            p.mass = (255 - count) / 6;
+            #if DEBUG_SERIAL
+            uint32_t flockStart = micros();
+            #endif
+            swarm.update(i, *spatialGrid);
+            #if DEBUG_SERIAL
+            flockMicros += micros() - flockStart;
+            #endif
 
             // Apply screen shake offset when drawing.
-            float drawX = boid->location.x + shakeOffsetX;
-            float drawY = boid->location.y + shakeOffsetY;
+            float drawX = swarm.x[i] + shakeOffsetX;
+            float drawY = swarm.y[i] + shakeOffsetY;
 
             // Hue based on velocity direction (if enabled).
             uint8_t renderHue;
             if (velocityBasedHue) {
-                float angle = atan2(boid->velocity.y, boid->velocity.x);
+                float angle = atan2(swarm.vy[i], swarm.vx[i]);
                 renderHue = (uint8_t)((angle + PI) * 40.7436f);
             } else {
-                renderHue = boid->hue * 15;
+                renderHue = p.hue * 15;
             }
 
-            drawVirtualF(ctx, drawX, drawY,
-                         ColorFromPalette(*currentPalette_p, renderHue, boid->brightness, NOBLEND));
+            splatX[i] = drawX;
+            splatY[i] = drawY;
+            splatColor[i] = ColorFromPalette(*currentPalette_p, renderHue, p.brightness, NOBLEND);
 
-            boid->neighbordist = neidist;
-            boid->desiredseparation = boidsep;
+            p.neighbordist = neidist;
+            p.desiredseparation = boidsep;
 
-            if (stopbool) boid->velocity = PVector(0, 0);
+            if (stopbool) {
+                swarm.vx[i] = 0;
+                swarm.vy[i] = 0;
+            }
         }
+        drawVirtualPointsF(ctx, count);
 
         if (fbActive) {
             // Steps 5-6: extract the 24x24 viewport (through the serpentine
             // Canvas::xy mapping), composite the overlay FX on top, then
             // ping-pong the virtual buffers.
             feedback.extractViewport(ctx.canvas, virtualViewX, virtualViewY);
-            ctx.overlay.update(ctx.canvas.raw());
+            ctx.overlay.update(ctx.canvas);
             feedback.endFrame();
         }
 
         #if DEBUG_SERIAL
+        flockFrames++;
         EVERY_N_SECONDS(5) {
+            Serial.print("[BOIDS] flocking (");
+            Serial.print(BoidSwarm::backendName(swarm.backend));
+            Serial.print("): ");
+            Serial.print(flockFrames ? flockMicros / flockFrames : 0);
+            Serial.println(" us/frame");
+            flockMicros = 0;
+            flockFrames = 0;
+
+            if (attractorGridActive()) {
+                AttractorForceGrid::ErrorStats err =
+                    attractorGrid.measureError(attractorField, swarm, count);
+                Serial.print("[ATTRACTOR GRID] pattern ");
+                Serial.print(currentAttractorPattern);
+                Serial.print(" res ");
+                Serial.print(attractorGrid.resolution());
+                Serial.print(": force error max ");
+                Serial.print(err.maxError, 4);
+                Serial.print(" mean ");
+                Serial.print(err.meanError, 4);
+                Serial.print(" (max exact force ");
+                Serial.print(err.maxExact, 4);
+                Serial.println(")");
+            }
+
             if (feedback.enabled()) {
                 Serial.print("[FEEDBACK] ");
                 Serial.print(feedback.presetName());
+                if (feedback.mesh.enabled()) {
+                    Serial.print(" + mesh ");
+                    Serial.print(feedback.mesh.name());
+                }
                 Serial.print(" pass: ");
                 Serial.print(feedback.lastPassMicros());
-                Serial.print(" us, FPS: ");
+                Serial.print(" us");
+                #if FEEDBACK_PARALLEL
+                Serial.print(" (bands ");
+                Serial.print(feedback.bandMicros(0));
+                Serial.print(" / ");
+                Serial.print(feedback.bandMicros(1));
+                Serial.print(" us)");
+                #endif
+                #if FEEDBACK_WARP_CACHE
+                Serial.print(", warp map hits ");
+                Serial.print(feedback.warpMapHits());
+                Serial.print(" / misses ");
+                Serial.print(feedback.warpMapMisses());
+                #endif
+                Serial.print(", FPS: ");
                 Serial.println(FastLED.getFPS());
             }
         }
@@ -237,7 +325,7 @@ private:
     static const uint8_t VIEWPORT_COLS = 24;
     static const int GRID_CELLS_X = 8;
     static const int GRID_CELLS_Y = 8;
-    static const int NUM_PARTICLES = 255;
+    static const int NUM_PARTICLES = BoidSwarm::CAPACITY;
     static const int MAX_ATTRACTORS = 17;
     static const int NUM_ATTRACTOR_PATTERNS = 11;
 
@@ -246,9 +334,18 @@ private:
     uint8_t virtualViewY = 24;
 
     // --- Particles + spatial partitioning ---------------------------------
-    Boid boids[NUM_PARTICLES];
+    BoidSwarm swarm;
     uint8_t count = 254;
     SpatialGrid* spatialGrid = nullptr;
+    // Per-frame draw queue, filled during the update loop and splatted in
+    // one drawVirtualPointsF() call.
+    float splatX[NUM_PARTICLES];
+    float splatY[NUM_PARTICLES];
+    CRGB splatColor[NUM_PARTICLES];
+    #if DEBUG_SERIAL
+    uint32_t flockMicros = 0; // time spent in swarm.update() since last log
+    uint32_t flockFrames = 0;
+    #endif
 
     // --- Attractors -------------------------------------------------------
     Attractor attractor5;   // Main central attractor
@@ -271,6 +368,17 @@ private:
     Attractor explosionRepulsor;
 
     Attractor* attractorArray[MAX_ATTRACTORS];
+    AttractorField attractorField; // active attractors, packed per frame
+    AttractorForceGrid attractorGrid{VIRTUAL_COLS, VIRTUAL_ROWS};
+    uint16_t attractorGridPatterns = ATTRACTOR_GRID_PATTERNS;
+
+    bool attractorGridActive() const {
+        #if BOID_PHYSICS_FIXED
+        return false;
+        #else
+        return (attractorGridPatterns >> currentAttractorPattern) & 1;
+        #endif
+    }
     bool attractorActive[MAX_ATTRACTORS] = {true, false, false, false, false, false,
                                             false, false, false, false, false, false,
                                             false, false, false, false, false};
@@ -317,22 +425,27 @@ private:
     unsigned long feedbackChangeDuration = 30000;
 
     // --- Drawing helper ---------------------------------------------------
-    // Draw a virtual-canvas coordinate with Wu anti-aliasing. When feedback is
-    // active, boids blend additively onto the recirculating virtual canvas
-    // (world space, so trails survive viewport movement); otherwise they map
-    // straight into the physical viewport as before.
-    void drawVirtualF(EffectContext& ctx, float virtualX, float virtualY, CRGB color) {
+    // Draw the first n queued splat points (virtual-canvas coordinates) with
+    // Wu anti-aliasing, in one batch. When feedback is active, boids blend
+    // additively onto the recirculating virtual canvas (world space, so trails
+    // survive viewport movement); otherwise they map straight into the
+    // physical viewport as before.
+    void drawVirtualPointsF(EffectContext& ctx, uint16_t n) {
         if (feedback.enabled()) {
-            feedback.drawPixelF(virtualX, virtualY, color);
+            feedback.drawPointsF(splatX, splatY, splatColor, n);
         } else {
-            ctx.canvas.drawPixelF(virtualX - virtualViewX, virtualY - virtualViewY, color);
+            for (uint16_t i = 0; i < n; i++) {
+                splatX[i] -= virtualViewX;
+                splatY[i] -= virtualViewY;
+            }
+            ctx.canvas.drawPointsF(splatX, splatY, splatColor, n);
         }
     }
 
     // --- Scene setup ------------------------------------------------------
     void start() {
         for (int i = 0; i < count; i++) {
-            boids[i] = Boid(random(COLS), 0);
+            swarm.spawn(i, random(COLS), 0);
         }
 
         attractor1.setlocation((virtualViewX + 24 / 2), (virtualViewY + 24 / 2));
@@ -732,43 +845,36 @@ private:
 
         ctx.overlay.startColorWash(1, 8, 25); // Vertical wash
 
-        spatialGrid->clear();
-        for (int i = 0; i < count; i++) {
-            Boid* boid = &boids[i];
-            spatialGrid->insert(boid, boid->location.x, boid->location.y);
-        }
-
         for (int j = 0; j < countto; j++) {
-            spatialGrid->clear();
-            for (int i = 0; i < count; i++) {
-                Boid* boid = &boids[i];
-                spatialGrid->insert(boid, boid->location.x, boid->location.y);
-            }
+            swarm.populateGrid(*spatialGrid, count);
 
             if (feedback.enabled()) feedback.beginFrame();
 
             for (int i = 0; i < count; i++) {
-                Boid* boid = &boids[i];
-                PVector force1 = attractor1.attract(*boid);
-                boid->applyForce(force1);
+                attractor1.applyTo(swarm, i);
 
-                boid->update(*spatialGrid);
-                boid->wrapAroundBorders(VIRTUAL_ROWS, VIRTUAL_COLS);
+                swarm.update(i, *spatialGrid);
+                swarm.wrapAroundBorders(i, VIRTUAL_ROWS, VIRTUAL_COLS);
 
-                drawVirtualF(ctx, boid->location.x, boid->location.y,
-                             ColorFromPalette(*currentPalette_p, boid->hue * 15, 255, NOBLEND));
-                boid->neighbordist = neidist;
-                boid->desiredseparation = boidsep;
+                splatX[i] = swarm.x[i];
+                splatY[i] = swarm.y[i];
+                splatColor[i] = ColorFromPalette(*currentPalette_p, swarm.params[i].hue * 15, 255, NOBLEND);
+                swarm.params[i].neighbordist = neidist;
+                swarm.params[i].desiredseparation = boidsep;
 
-                if (stopbool) boid->velocity = PVector(0, 0);
+                if (stopbool) {
+                    swarm.vx[i] = 0;
+                    swarm.vy[i] = 0;
+                }
             }
+            drawVirtualPointsF(ctx, count);
 
             if (feedback.enabled()) {
                 feedback.extractViewport(ctx.canvas, virtualViewX, virtualViewY);
-                ctx.overlay.update(ctx.canvas.raw());
+                ctx.overlay.update(ctx.canvas);
                 feedback.endFrame();
             } else {
-                ctx.overlay.update(ctx.canvas.raw());
+                ctx.overlay.update(ctx.canvas);
                 ctx.canvas.fade(CRGB::Black, 45);
             }
             ctx.canvas.show();
@@ -792,7 +898,7 @@ private:
         if (!isSlowingDown && !isPaused) {
             isSlowingDown = true;
             for (int i = 0; i < count; i++) {
-                originalSpeeds[i] = boids[i].maxspeed;
+                originalSpeeds[i] = swarm.params[i].maxspeed;
             }
             ctx.overlay.startScreenShake(8, 1);
         }
@@ -801,11 +907,11 @@ private:
         if (isSlowingDown) {
             bool allStopped = true;
             for (int i = 0; i < count; i++) {
-                if (boids[i].maxspeed > 0.2) {
-                    boids[i].maxspeed -= 0.1;
+                if (swarm.params[i].maxspeed > 0.2) {
+                    swarm.params[i].maxspeed -= 0.1;
                     allStopped = false;
                 } else {
-                    boids[i].maxspeed = 0;
+                    swarm.params[i].maxspeed = 0;
                 }
             }
 
@@ -822,7 +928,7 @@ private:
         if (isPaused && (millis() - pauseStartTime >= pauseDuration)) {
             isPaused = false;
             for (int i = 0; i < count; i++) {
-                boids[i].maxspeed = random(1.1F, 2.0F);
+                swarm.params[i].maxspeed = random(1.1F, 2.0F);
             }
             lastSlowDownTime = millis();
             nextSlowDownInterval = random(10000, 40000);
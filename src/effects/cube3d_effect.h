@@ -64,14 +64,27 @@ private:
         {-1,-1, 1}, {1,-1, 1}, {1,1, 1}, {-1,1, 1}};
     static constexpr uint8_t E[12][2] = {
         {0,1},{1,2},{2,3},{3,0}, {4,5},{5,6},{6,7},{7,4}, {0,4},{1,5},{2,6},{3,7}};
+    static const uint8_t LINE_BATCH = 64;
 
     void line(Canvas& c, float x0, float y0, float x1, float y1, CRGB col) {
         float dx = x1 - x0, dy = y1 - y0;
         int steps = (int)(max(fabsf(dx), fabsf(dy)) * 2) + 1;
+
+        // Splat the samples in batches of LINE_BATCH.
+        float xs[LINE_BATCH], ys[LINE_BATCH];
+        CRGB cols[LINE_BATCH];
+        uint8_t n = 0;
         for (int i = 0; i <= steps; i++) {
             float t = (float)i / steps;
-            c.drawPixelF(x0 + dx * t, y0 + dy * t, col);
+            xs[n] = x0 + dx * t;
+            ys[n] = y0 + dy * t;
+            cols[n] = col;
+            if (++n == LINE_BATCH) {
+                c.drawPointsF(xs, ys, cols, n);
+                n = 0;
+            }
         }
+        c.drawPointsF(xs, ys, cols, n);
     }
 };
 
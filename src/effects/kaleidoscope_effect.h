@@ -29,18 +29,20 @@ public:
         const uint8_t hw = (W + 1) / 2;
         const uint8_t hh = (H + 1) / 2;
 
+        CRGB line[COLS];
         for (uint8_t y = 0; y < hh; y++) {
             for (uint8_t x = 0; x < hw; x++) {
                 uint8_t idx = inoise8(x * 50 + t, y * 50 - t, t >> 1) + (x * y);
                 uint8_t bri = qadd8(inoise8(x * 40, y * 40, t), 40);
                 CRGB col = ColorFromPalette(*currentPalette_p, idx, bri, LINEARBLEND);
 
-                // 4-fold mirror.
-                c.setPixel(x, y, col);
-                c.setPixel(W - 1 - x, y, col);
-                c.setPixel(x, H - 1 - y, col);
-                c.setPixel(W - 1 - x, H - 1 - y, col);
+                // Mirror left/right within the scanline...
+                line[x] = col;
+                line[W - 1 - x] = col;
             }
+            // ...and top/bottom by writing it to both rows.
+            c.writeRow(y, line);
+            c.writeRow(H - 1 - y, line);
         }
         t += 6;
     }
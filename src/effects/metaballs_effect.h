@@ -40,6 +40,7 @@ public:
         }
 
         for (uint8_t y = 0; y < c.height; y++) {
+            Canvas::RowSpan row = c.row(y);
             for (uint8_t x = 0; x < c.width; x++) {
                 float sum = 0;
                 for (uint8_t i = 0; i < N; i++) {
@@ -48,7 +49,7 @@ public:
                 }
                 uint8_t bri = (uint8_t)constrain((int)(sum * 130), 0, 255);
                 uint8_t idx = (uint8_t)(sum * 36) + hue;
-                c.setPixel(x, y, ColorFromPalette(*currentPalette_p, idx, bri, LINEARBLEND));
+                row[x] = ColorFromPalette(*currentPalette_p, idx, bri, LINEARBLEND);
             }
         }
         hue++;
@@ -25,19 +25,26 @@ public:
         Canvas& c = ctx.canvas;
         c.fade(CRGB::Black, 48); // tails
 
+        float xs[N * 2], ys[N * 2];
+        CRGB cols[N * 2];
         for (uint8_t i = 0; i < N; i++) {
             Meteor& q = m[i];
             q.x += q.vx;
             q.y += q.vy;
 
-            // Bright head + a small leading glow.
-            c.drawPixelF(q.x, q.y, CHSV(q.hue, 200, 255));
-            c.drawPixelF(q.x - q.vx * 0.5f, q.y - q.vy * 0.5f, CHSV(q.hue, 220, 120));
+            // Bright head + a small leading glow, splatted after the loop.
+            xs[i * 2] = q.x;
+            ys[i * 2] = q.y;
+            cols[i * 2] = CHSV(q.hue, 200, 255);
+            xs[i * 2 + 1] = q.x - q.vx * 0.5f;
+            ys[i * 2 + 1] = q.y - q.vy * 0.5f;
+            cols[i * 2 + 1] = CHSV(q.hue, 220, 120);
 
             if (q.x < -2 || q.x > c.width + 2 || q.y > c.height + 2) {
                 respawn(q, false);
             }
         }
+        c.drawPointsF(xs, ys, cols, N * 2);
     }
 
 private:
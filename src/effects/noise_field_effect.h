@@ -28,10 +28,11 @@ public:
     void update(EffectContext& ctx, uint32_t) override {
         Canvas& c = ctx.canvas;
         for (uint8_t y = 0; y < c.height; y++) {
+            Canvas::RowSpan row = c.row(y);
             for (uint8_t x = 0; x < c.width; x++) {
                 uint8_t idx = inoise8(x * 24 + ox, y * 24 + oy, z);
                 uint8_t bri = scale8(inoise8(x * 24 + ox + 5000, y * 24 + oy, z), 200) + 55;
-                c.setPixel(x, y, ColorFromPalette(*currentPalette_p, idx, bri, LINEARBLEND));
+                row[x] = ColorFromPalette(*currentPalette_p, idx, bri, LINEARBLEND);
             }
         }
         z += 12;
@@ -32,13 +32,14 @@ public:
         t += 2; // animation phase advance
 
         for (uint8_t y = 0; y < c.height; y++) {
+            Canvas::RowSpan row = c.row(y);
             for (uint8_t x = 0; x < c.width; x++) {
                 // Classic additive sine plasma.
                 uint8_t v = sin8(x * 12 + t)
                           + sin8(y * 16 - t)
                           + sin8((x + y) * 8 + t / 2);
                 CRGB color = ColorFromPalette(*currentPalette_p, v, 255, LINEARBLEND);
-                c.setPixel(x, y, color);
+                row[x] = color;
             }
         }
     }
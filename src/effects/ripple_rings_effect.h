@@ -45,19 +45,25 @@ public:
             if (q.radius > maxR) { q.active = false; continue; }
 
             uint8_t bri = (uint8_t)(255 * (1.0f - q.radius / maxR));
-            for (int a = 0; a < 360; a += 6) {
-                float rad = a * DEG_TO_RAD;
-                float px = q.cx + cosf(rad) * q.radius;
-                float py = q.cy + sinf(rad) * q.radius;
-                CRGB col = ColorFromPalette(*currentPalette_p,
-                                            q.hue + (uint8_t)(q.radius * 4), bri, LINEARBLEND);
-                c.drawPixelF(px, py, col);
+            CRGB col = ColorFromPalette(*currentPalette_p,
+                                        q.hue + (uint8_t)(q.radius * 4), bri, LINEARBLEND);
+
+            // Sample the ring every 6 degrees and splat it in one batch.
+            float xs[RING_SAMPLES], ys[RING_SAMPLES];
+            CRGB cols[RING_SAMPLES];
+            for (uint8_t k = 0; k < RING_SAMPLES; k++) {
+                float rad = (k * 6) * DEG_TO_RAD;
+                xs[k] = q.cx + cosf(rad) * q.radius;
+                ys[k] = q.cy + sinf(rad) * q.radius;
+                cols[k] = col;
             }
+            c.drawPointsF(xs, ys, cols, RING_SAMPLES);
         }
     }
 
 private:
     static const uint8_t MAXR = 10;
+    static const uint8_t RING_SAMPLES = 60; // one per 6 degrees
     struct Ripple { float cx, cy, radius; uint8_t hue; bool active; };
     Ripple r[MAXR];
     uint32_t lastSpawn = 0;
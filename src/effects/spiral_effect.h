@@ -28,13 +28,14 @@ public:
         const float cy = (c.height - 1) / 2.0f;
 
         for (uint8_t y = 0; y < c.height; y++) {
+            Canvas::RowSpan row = c.row(y);
             for (uint8_t x = 0; x < c.width; x++) {
                 float dx = x - cx, dy = y - cy;
                 float r = sqrtf(dx * dx + dy * dy);
                 float a = atan2f(dy, dx);
                 float v = sinf(a * ARMS + r * 0.55f - t);   // -1..1
                 uint8_t idx = (uint8_t)((v * 0.5f + 0.5f) * 255) + (uint8_t)(r * 6);
-                c.setPixel(x, y, ColorFromPalette(*currentPalette_p, idx, 255, LINEARBLEND));
+                row[x] = ColorFromPalette(*currentPalette_p, idx, 255, LINEARBLEND);
             }
         }
         t += 0.16f;
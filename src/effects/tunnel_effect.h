@@ -29,6 +29,7 @@ public:
         const float cy = (c.height - 1) / 2.0f;
 
         for (uint8_t y = 0; y < c.height; y++) {
+            Canvas::RowSpan row = c.row(y);
             for (uint8_t x = 0; x < c.width; x++) {
                 float dx = x - cx, dy = y - cy;
                 float dist = sqrtf(dx * dx + dy * dy) + 0.5f;
@@ -39,7 +40,7 @@ public:
                 uint8_t idx = depth + ang + t;
                 uint8_t bri = (uint8_t)constrain((int)(dist * 24), 30, 255);
 
-                c.setPixel(x, y, ColorFromPalette(*currentPalette_p, idx, bri, LINEARBLEND));
+                row[x] = ColorFromPalette(*currentPalette_p, idx, bri, LINEARBLEND);
             }
         }
         t += 3;
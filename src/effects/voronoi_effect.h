@@ -41,6 +41,7 @@ public:
         }
 
         for (uint8_t y = 0; y < c.height; y++) {
+            Canvas::RowSpan row = c.row(y);
             for (uint8_t x = 0; x < c.width; x++) {
                 float d1 = 1e9f, d2 = 1e9f;
                 uint8_t n1 = 0;
@@ -52,7 +53,7 @@ public:
                 }
                 float edge = sqrtf(d2) - sqrtf(d1);
                 uint8_t bri = edge < 1.4f ? (uint8_t)(edge / 1.4f * 255) : 255;
-                c.setPixel(x, y, ColorFromPalette(*currentPalette_p, s[n1].hue, bri, LINEARBLEND));
+                row[x] = ColorFromPalette(*currentPalette_p, s[n1].hue, bri, LINEARBLEND);
             }
         }
     }
@@ -37,6 +37,7 @@ public:
         }
 
         for (uint8_t y = 0; y < c.height; y++) {
+            Canvas::RowSpan row = c.row(y);
             for (uint8_t x = 0; x < c.width; x++) {
                 float sum = 0;
                 for (uint8_t i = 0; i < SRC; i++) {
@@ -45,7 +46,7 @@ public:
                     sum += sinf(d * 0.85f - t * 3.0f);
                 }
                 uint8_t idx = (uint8_t)((sum / SRC * 0.5f + 0.5f) * 255);
-                c.setPixel(x, y, ColorFromPalette(*currentPalette_p, idx, 255, LINEARBLEND));
+                row[x] = ColorFromPalette(*currentPalette_p, idx, 255, LINEARBLEND);
             }
         }
         t += 0.06f;
@@ -0,0 +1,114 @@
+#ifndef FADE_TABLES_H
+#define FADE_TABLES_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include "simd_utils.h"
+
+// Number of fade tables kept by FadeTableCache (768 bytes each). 0 disables
+// the tables and Canvas::fade() runs the arithmetic kernel directly.
+#ifndef FADE_LUT_SLOTS
+#define FADE_LUT_SLOTS 4
+#endif
+
+// ---------------------------------------------------------------------------
+// FadeTable: simd_fade_to_color() as three 256-entry lookup tables.
+//
+// The fade maps each channel value independently, and the mapping depends
+// only on (value, target channel, fadeAmt, rran). For a fixed (target,
+// fadeAmt, rran) the whole frame fade is therefore three table lookups per
+// LED. Tables are filled with the same per-channel helpers the arithmetic
+// kernel uses, so the result is bit-identical to simd_fade_to_color().
+// ---------------------------------------------------------------------------
+struct FadeTable {
+    uint8_t r[256];
+    uint8_t g[256];
+    uint8_t b[256];
+
+    void build(CRGB target, uint8_t fadeAmt, int rr) {
+        if (rr < 1 || rr > 258) {
+            // Outside the fast red path's range: evaluate the reference.
+            for (int v = 0; v < 256; v++) {
+                CRGB px(v, v, v);
+                fade_pixel_reference(&px, target, fadeAmt, rr);
+                r[v] = px.r;
+                g[v] = px.g;
+                b[v] = px.b;
+            }
+            return;
+        }
+        const uint32_t rranRecip = rr > 1 ? (uint32_t)(0xFFFFFFFFu / (uint32_t)rr + 1) : 0;
+        for (int v = 0; v < 256; v++) {
+            r[v] = fade_red(v, target.r, fadeAmt, rr, rranRecip);
+            g[v] = fade_channel(v, target.g, fadeAmt);
+            b[v] = fade_channel(v, target.b, fadeAmt);
+        }
+    }
+
+    void apply(CRGB* leds, int count) const {
+        for (int i = 0; i < count; i++) {
+            leds[i].r = r[leds[i].r];
+            leds[i].g = g[leds[i].g];
+            leds[i].b = b[leds[i].b];
+        }
+    }
+};
+
+// ---------------------------------------------------------------------------
+// FadeTableCache: the last few FadeTables, built lazily.
+//
+// Fade parameters change rarely (each effect fades with a fixed amount, and
+// rran only changes with the boids' color refresh), so a lookup almost always
+// hits. Several slots with least-recently-used replacement keep effects that
+// alternate between a few amounts - or an effect switch and back - from
+// rebuilding a table every frame.
+// ---------------------------------------------------------------------------
+class FadeTableCache {
+public:
+    static const uint8_t SLOTS = FADE_LUT_SLOTS > 0 ? FADE_LUT_SLOTS : 1;
+
+    const FadeTable& get(CRGB target, uint8_t fadeAmt, int rr) {
+        const uint32_t key = ((uint32_t)target.r << 24) | ((uint32_t)target.g << 16) |
+                             ((uint32_t)target.b << 8) | fadeAmt;
+        useClock++;
+
+        uint8_t victim = 0;
+        for (uint8_t s = 0; s < SLOTS; s++) {
+            Slot& slot = slots[s];
+            if (slot.valid && slot.key == key && slot.rran == rr) {
+                slot.lastUse = useClock;
+                hits++;
+                return slot.table;
+            }
+            if (!slot.valid || (slots[victim].valid && slot.lastUse < slots[victim].lastUse)) {
+                victim = s;
+            }
+        }
+
+        Slot& slot = slots[victim];
+        slot.table.build(target, fadeAmt, rr);
+        slot.key = key;
+        slot.rran = rr;
+        slot.lastUse = useClock;
+        slot.valid = true;
+        builds++;
+        return slot.table;
+    }
+
+    uint32_t hits = 0;
+    uint32_t builds = 0;
+
+private:
+    struct Slot {
+        FadeTable table;
+        uint32_t key = 0;  // target RGB << 8 | fadeAmt
+        int rran = 0;
+        uint32_t lastUse = 0;
+        bool valid = false;
+    };
+
+    Slot slots[SLOTS];
+    uint32_t useClock = 0;
+};
+
+#endif // FADE_TABLES_H
@@ -5,6 +5,8 @@
 #include <FastLED.h>
 #include "config.h"
 #include "canvas.h"
+#include "core_worker.h"
+#include "warp_mesh.h"
 
 // ---------------------------------------------------------------------------
 // VideoFeedback: Milkdrop/AVS-style video feedback buffer.
@@ -17,7 +19,8 @@
 //
 // The feedback pass runs in VIRTUAL space (48x48, plain row-major indexing) so
 // trails live in world coordinates and survive viewport movement. Serpentine
-// mapping only ever happens at viewport extraction time, through Canvas::xy().
+// mapping only ever happens at viewport extraction time, through
+// Canvas::writeRow().
 //
 // Hot-loop math: the per-frame transform is set up once in float (the S3 has
 // an FPU), then converted to 16.16 fixed point and applied incrementally per
@@ -26,6 +29,33 @@
 // used here (+/-0.005..0.05 rad), so one sinf/cosf pair per frame is used
 // instead. Bilinear sampling reuses the same Wu weight formula as
 // Canvas::drawPixelF for consistency.
+//
+// With FEEDBACK_PARALLEL the resample is split into two row bands: rows
+// [splitRow, H) go to a CoreWorker on the other core while the caller does
+// [0, splitRow). beginFrame() returns without waiting for the worker; the
+// first access to the current buffer (drawing, extractViewport, endFrame)
+// is the barrier. Each band is timed separately (bandMicros()).
+//
+// The bilinear kernel (see FeedbackKernel) defaults to a SWAR version that
+// reads an RGBx copy of the source - one 32-bit word per pixel - and blends
+// red and blue in the two 16-bit halves of one multiply-accumulate. It is
+// bit-exact with the per-channel reference kernel, which stays selectable
+// at runtime for golden comparisons.
+//
+// With FEEDBACK_WARP_CACHE the per-pixel footprints (source index + Wu
+// weights) are kept in a warp map, rebuilt only when the 16.16 transform
+// changes. The modulation noise is 8-bit, so the transform often holds for
+// several frames; those frames are a gather and a weighted sum per pixel.
+// To make that more common the transform is rounded to drop its low
+// FEEDBACK_WARP_QUANT_BITS bits first, so nearly equal transforms share a
+// map. This is a small deviation from the exact transform (see the macro);
+// warpQuantBits = 0 keeps the exact one for golden runs.
+// warpMapHits() / warpMapMisses() count how often the map is reused.
+//
+// A warp mesh (see warp_mesh.h) can displace the transform per vertex -
+// ripples, swirls, bulges - on top of the preset's zoom/rotation/drift. The
+// mesh changes every frame, so it bypasses the warp map; its vertices are
+// interpolated into per-pixel source positions in fixed point.
 // ---------------------------------------------------------------------------
 
 // Out-of-bounds handling default for the resample: 1 = wrap toroidally
@@ -35,6 +65,46 @@
 #define FEEDBACK_WRAP 1
 #endif
 
+// Resample in two row bands on both cores (see above). The worker runs on
+// FEEDBACK_WORKER_CORE; loop() itself runs on core 1.
+#ifndef FEEDBACK_PARALLEL
+#define FEEDBACK_PARALLEL 0
+#endif
+#ifndef FEEDBACK_WORKER_CORE
+#define FEEDBACK_WORKER_CORE 0
+#endif
+
+// Bilinear kernel the resample starts with (see FeedbackKernel). Also
+// switchable at runtime via VideoFeedback::setKernel().
+#ifndef FEEDBACK_KERNEL
+#define FEEDBACK_KERNEL 1
+#endif
+
+// Keep the per-pixel warp map between frames (see above, ~13.5 KB). Off by
+// default: a map hit costs ~0.55x a plain resample on the host and a
+// rebuild ~1.15x, so it needs about one hit in three to pay off, and the
+// modulated presets reach ~15% at the default FEEDBACK_WARP_QUANT_BITS.
+#ifndef FEEDBACK_WARP_CACHE
+#define FEEDBACK_WARP_CACHE 0
+#endif
+
+// Low bits dropped from each 16.16 transform term before a cached resample,
+// so nearly equal transforms share one warp map. Pixel (47, 47) sums the
+// origin and 94 steps, so it moves by at most 95 * 2^(bits - 1) / 65536 px:
+// ~0.012 px at 4. Coarser rounding raises the hit rate (~65% at 8) but
+// steps the rotation by 2^bits / 65536 rad per frame, a large share of the
+// slow presets' 0.005 rad. Also settable at runtime via
+// VideoFeedback::warpQuantBits; 0 = exact, for golden runs.
+#ifndef FEEDBACK_WARP_QUANT_BITS
+#define FEEDBACK_WARP_QUANT_BITS 4
+#endif
+
+enum FeedbackKernel : uint8_t {
+    FEEDBACK_KERNEL_REFERENCE = 0, // per-channel taps straight from the CRGB buffer
+    FEEDBACK_KERNEL_SWAR,          // two channels per multiply from an RGBx copy
+    FEEDBACK_KERNEL_COUNT
+};
+
 enum FeedbackPreset : uint8_t {
     FEEDBACK_OFF = 0,     // feedback disabled - original render path
     FEEDBACK_TUNNEL_IN,   // content spirals inward
@@ -65,9 +135,27 @@ class VideoFeedback {
 public:
     static const uint8_t W = 48;
     static const uint8_t H = 48;
+    static const uint8_t BANDS = 2;
 
     FeedbackParams params;
 
+    // First row of the worker's band with FEEDBACK_PARALLEL. Move it to
+    // rebalance when bandMicros() shows one core finishing early.
+    uint8_t splitRow = H / 2;
+
+    // Bilinear kernel of the resample. Both produce the same pixels; the
+    // reference one is kept for golden comparisons.
+    FeedbackKernel kernel = (FeedbackKernel)FEEDBACK_KERNEL;
+
+    #if FEEDBACK_WARP_CACHE
+    // Transform bits dropped to share the warp map (see
+    // FEEDBACK_WARP_QUANT_BITS); 0 for golden runs.
+    uint8_t warpQuantBits = FEEDBACK_WARP_QUANT_BITS;
+    #endif
+
+    // Per-vertex warp applied on top of params (mesh.mode, mesh.amount).
+    WarpMesh<W, H, FEEDBACK_MESH_SIZE> mesh;
+
     // --- Preset control -----------------------------------------------------
     void setPreset(FeedbackPreset p) {
         bool wasEnabled = params.enabled;
@@ -96,6 +184,30 @@ public:
 
     bool enabled() const { return params.enabled; }
 
+    void setMesh(FeedbackMesh m) {
+        mesh.mode = m;
+        #if DEBUG_SERIAL
+        Serial.print("[FEEDBACK] Mesh: ");
+        Serial.println(mesh.name());
+        #endif
+    }
+
+    void nextMesh() {
+        setMesh((FeedbackMesh)((mesh.mode + 1) % MESH_COUNT));
+    }
+
+    void setKernel(FeedbackKernel k) {
+        kernel = k;
+        #if DEBUG_SERIAL
+        Serial.print("[FEEDBACK] Kernel: ");
+        Serial.println(kernel == FEEDBACK_KERNEL_SWAR ? "SWAR" : "REFERENCE");
+        #endif
+    }
+
+    void nextKernel() {
+        setKernel((FeedbackKernel)((kernel + 1) % FEEDBACK_KERNEL_COUNT));
+    }
+
     // Future audio-reactive hook: 0-255 energy scales zoom deviation and
     // rotation speed. Until an external driver calls this, a slow Perlin
     // walk drives the modulation instead.
@@ -109,16 +221,16 @@ public:
     // with the inverse transform + decay. Writes every pixel of curr, so no
     // separate canvas clear is needed (decay is the clear).
     void beginFrame() {
+        finishResample();
         if (!params.enabled) return;
         updateModulation();
-        uint32_t t0 = micros();
         resample();
-        lastPassUs = micros() - t0;
     }
 
     // Last step of the frame: ping-pong the buffers so everything drawn this
     // frame (feedback + boids) becomes next frame's source.
     void endFrame() {
+        finishResample();
         if (!params.enabled) return;
         CRGB* t = prev;
         prev = curr;
@@ -126,64 +238,106 @@ public:
     }
 
     void clear() {
-        fill_solid(bufA, W * H, CRGB::Black);
-        fill_solid(bufB, W * H, CRGB::Black);
+        finishResample();
+        fill_solid(bufA, STRIDE * PADDED_H, CRGB::Black);
+        fill_solid(bufB, STRIDE * PADDED_H, CRGB::Black);
     }
 
+    // Resample time of the last frame: the slower band when parallel.
     uint32_t lastPassMicros() const { return lastPassUs; }
+    // Time of one band (0 = caller's rows, 1 = worker's rows) last frame.
+    uint32_t bandMicros(uint8_t band) const { return band < BANDS ? bandUs[band] : 0; }
+
+    // Resamples that reused the cached warp map / had to rebuild it.
+    uint32_t warpMapHits() const { return warpHits; }
+    uint32_t warpMapMisses() const { return warpMisses; }
 
     // --- Drawing into the virtual canvas ------------------------------------
     // Sub-pixel additive draw, mirroring Canvas::drawPixelF (Wu weights +
     // qadd8) so boids look identical whether they land on the physical canvas
     // or the feedback buffer. Edge spill wraps when params.wrap is set.
     void drawPixelF(float fx, float fy, CRGB color) {
-        if (fx < 0 || fx >= W || fy < 0 || fy >= H) return;
-
-        uint8_t xx = (fx - (int)fx) * 255, yy = (fy - (int)fy) * 255;
-        uint8_t ix = 255 - xx, iy = 255 - yy;
-
-        uint8_t wu[4] = {FB_WU_WEIGHT(ix, iy), FB_WU_WEIGHT(xx, iy),
-                         FB_WU_WEIGHT(ix, yy), FB_WU_WEIGHT(xx, yy)};
+        drawPointsF(&fx, &fy, &color, 1);
+    }
 
-        for (uint8_t i = 0; i < 4; i++) {
-            int16_t xn = (int16_t)fx + (i & 1), yn = (int16_t)fy + ((i >> 1) & 1);
+    // Batched drawPixelF(), mirroring Canvas::drawPointsF: one clip per
+    // point, then all four neighbors without checks unless the point sits on
+    // the right/bottom edge with wrapping off.
+    void drawPointsF(const float* xs, const float* ys, const CRGB* colors, uint16_t n) {
+        finishResample();
+        for (uint16_t k = 0; k < n; k++) {
+            const float fx = xs[k], fy = ys[k];
+            if (fx < 0 || fx >= W || fy < 0 || fy >= H) continue;
+
+            const int16_t x0 = (int16_t)fx, y0 = (int16_t)fy;
+            int16_t x1 = x0 + 1, y1 = y0 + 1;
             if (params.wrap) {
-                if (xn >= W) xn -= W;
-                if (yn >= H) yn -= H;
+                if (x1 >= W) x1 -= W;
+                if (y1 >= H) y1 -= H;
             }
-            if (xn >= 0 && xn < W && yn >= 0 && yn < H) {
-                CRGB& c = curr[(uint16_t)yn * W + xn];
-                c.r = qadd8(c.r, (color.r * wu[i]) >> 8);
-                c.g = qadd8(c.g, (color.g * wu[i]) >> 8);
-                c.b = qadd8(c.b, (color.b * wu[i]) >> 8);
+
+            uint8_t xx = (fx - x0) * 255, yy = (fy - y0) * 255;
+            uint8_t ix = 255 - xx, iy = 255 - yy;
+
+            const uint8_t w00 = FB_WU_WEIGHT(ix, iy), w10 = FB_WU_WEIGHT(xx, iy);
+            const uint8_t w01 = FB_WU_WEIGHT(ix, yy), w11 = FB_WU_WEIGHT(xx, yy);
+
+            const CRGB color = colors[k];
+            CRGB* row0 = curr + (uint16_t)y0 * STRIDE;
+            splat(row0[x0], color, w00);
+            if (x1 < W && y1 < H) {
+                CRGB* row1 = curr + (uint16_t)y1 * STRIDE;
+                splat(row0[x1], color, w10);
+                splat(row1[x0], color, w01);
+                splat(row1[x1], color, w11);
+            } else {
+                if (x1 < W) splat(row0[x1], color, w10);
+                if (y1 < H) splat(curr[(uint16_t)y1 * STRIDE + x0], color, w01);
             }
         }
     }
 
     // Copy the viewport window out of the virtual canvas into the physical
-    // frame buffer. All physical output still goes through Canvas::xy(), so
-    // the serpentine mapping is untouched.
+    // frame buffer, one scanline at a time. The Canvas owns the physical
+    // mapping, so the serpentine layout is untouched.
     void extractViewport(Canvas& canvas, uint8_t viewX, uint8_t viewY) {
-        CRGB* out = canvas.raw();
+        finishResample();
         for (uint8_t y = 0; y < canvas.height; y++) {
-            const CRGB* src = curr + (uint16_t)(viewY + y) * W + viewX;
-            for (uint8_t x = 0; x < canvas.width; x++) {
-                out[canvas.xy(x, y)] = src[x];
-            }
+            canvas.writeRow(y, curr + (uint16_t)(viewY + y) * STRIDE + viewX);
         }
     }
 
 private:
-    // Static double buffer (~6.9 KB each) - no heap use in the frame loop.
-    CRGB bufA[W * H];
-    CRGB bufB[W * H];
-    CRGB* prev = bufA;
-    CRGB* curr = bufB;
+    static void splat(CRGB& px, CRGB color, uint8_t weight) {
+        px.r = qadd8(px.r, (color.r * weight) >> 8);
+        px.g = qadd8(px.g, (color.g * weight) >> 8);
+        px.b = qadd8(px.b, (color.b * weight) >> 8);
+    }
+
+    // Each buffer carries a GUARD-pixel border around the W x H image, so
+    // the resample can read taps up to GUARD pixels outside it without
+    // checks. Before each resample the source's border is refreshed: a
+    // toroidal copy of the opposite edge when wrapping, black when clamping.
+    // Nothing else writes the border; prev/curr point at pixel (0, 0).
+    static const uint8_t GUARD = 2;
+    static const uint16_t STRIDE = W + 2 * GUARD;
+    static const uint16_t PADDED_H = H + 2 * GUARD;
+    static const uint16_t ORIGIN = GUARD * STRIDE + GUARD;
+
+    // Static double buffer (~8.1 KB each) - no heap use in the frame loop.
+    CRGB bufA[STRIDE * PADDED_H];
+    CRGB bufB[STRIDE * PADDED_H];
+    // RGBx copy of the source (guard included) for the SWAR kernel, ~10.8 KB.
+    uint32_t rgbx[STRIDE * PADDED_H];
+    CRGB* prev = bufA + ORIGIN;
+    CRGB* curr = bufB + ORIGIN;
 
     FeedbackPreset preset_ = FEEDBACK_OFF;
     uint8_t modEnergy = 128;
     bool externalMod = false;
     uint32_t lastPassUs = 0;
+    uint32_t warpHits = 0;
+    uint32_t warpMisses = 0;
 
     // Static (non-modulated) parameter baseline for each preset.
     void applyPresetBase() {
@@ -274,6 +428,32 @@ private:
         }
     }
 
+    // One destination pixel's bilinear footprint: the index of its top-left
+    // tap in the padded buffer and the four Wu weights.
+    struct WarpTap {
+        uint16_t index;
+        uint8_t w00, w10, w01, w11;
+    };
+
+    // Per-frame transform in 16.16 fixed point, shared by both bands.
+    struct ResampleSetup {
+        const CRGB* src;
+        const CRGB* srcBuf;      // padded buffer holding src
+        const uint32_t* srcRgbx; // RGBx copy of srcBuf, SWAR kernel only
+        CRGB* dst;
+        int32_t sx00, sy00;   // source coordinate of destination (0,0)
+        int32_t dxCol, dyCol; // source step per destination column
+        int32_t dxRow, dyRow; // source step per destination row
+        uint8_t eff;          // decay * intensity
+        bool wrap;
+        bool inGuard;         // every tap lies within the image + guard
+        uint8_t split;        // first row of the worker's band
+        bool swar;            // blend with the RGBx kernel
+        bool buildMap;        // warp map out of date: rebuild it on the way
+        WarpTap* map;
+        const WarpMesh<W, H, FEEDBACK_MESH_SIZE>* mesh; // per-pixel positions, or null
+    };
+
     // The feedback resample: for every destination pixel, apply the inverse
     // transform (translate center to origin, rotate by -angle, scale by
     // 1/zoom, translate back, add drift), bilinearly sample prev, attenuate
@@ -291,84 +471,382 @@ private:
         const float sx00 = cx + (-cx) * ca + (-cy) * sa + params.driftX;
         const float sy00 = cy - (-cx) * sa + (-cy) * ca + params.driftY;
 
-        const int32_t dxCol = (int32_t)lrintf(ca * 65536.0f);
-        const int32_t dyCol = (int32_t)lrintf(-sa * 65536.0f);
-        const int32_t dxRow = (int32_t)lrintf(sa * 65536.0f);
-        const int32_t dyRow = (int32_t)lrintf(ca * 65536.0f);
-
-        int32_t rowSx = (int32_t)lrintf(sx00 * 65536.0f);
-        int32_t rowSy = (int32_t)lrintf(sy00 * 65536.0f);
-
-        const int32_t WFP = (int32_t)W << 16;
-        const int32_t HFP = (int32_t)H << 16;
+        setup.dxCol = (int32_t)lrintf(ca * 65536.0f);
+        setup.dyCol = (int32_t)lrintf(-sa * 65536.0f);
+        setup.dxRow = (int32_t)lrintf(sa * 65536.0f);
+        setup.dyRow = (int32_t)lrintf(ca * 65536.0f);
+        setup.sx00 = (int32_t)lrintf(sx00 * 65536.0f);
+        setup.sy00 = (int32_t)lrintf(sy00 * 65536.0f);
+        #if FEEDBACK_WARP_CACHE
+        // Rounded before anything uses it, so a frame that builds the map and
+        // one that reuses it produce the same pixels.
+        if (!mesh.enabled()) quantizeTransform(setup, warpQuantBits);
+        #endif
 
         // Fold the intensity crossfade into the decay so the inner loop only
         // scales once per pixel.
-        const uint8_t eff = scale8(params.decay, params.intensity);
-        const bool wrap = params.wrap;
+        setup.eff = scale8(params.decay, params.intensity);
+        setup.wrap = params.wrap;
+        setup.src = prev;
+        setup.srcBuf = prev - ORIGIN;
+        setup.dst = curr;
+        setup.split = splitRow < H ? splitRow : H;
+        setup.inGuard = footprintInGuard(setup);
+        refreshGuard(prev, setup.wrap);
+        setup.mesh = nullptr;
+        if (mesh.enabled()) {
+            mesh.evaluate(setup.sx00, setup.sy00, setup.dxCol, setup.dyCol,
+                          setup.dxRow, setup.dyRow, millis());
+            setup.mesh = &mesh;
+        }
+        #if FEEDBACK_WARP_CACHE
+        setup.swar = kernel == FEEDBACK_KERNEL_SWAR;
+        setup.buildMap = !setup.mesh && (!warpValid || !sameTransform(setup, warpKey));
+        setup.map = warpMap;
+        if (setup.mesh) {
+            warpValid = false;
+        } else if (setup.buildMap) {
+            warpKey = setup;
+            warpValid = true;
+            warpMisses++;
+        } else {
+            warpHits++;
+        }
+        #else
+        // The clamp loop outside the guard always runs the reference kernel.
+        setup.swar = kernel == FEEDBACK_KERNEL_SWAR && (setup.mesh || setup.inGuard || setup.wrap);
+        #endif
+        setup.srcRgbx = rgbx;
+        if (setup.swar) packRgbx(setup.srcBuf, rgbx);
+
+        #if FEEDBACK_PARALLEL
+        worker.dispatch(workerBand, this);
+        resampleBand(0, 0, setup.split);
+        resamplePending = true;
+        #else
+        resampleBand(0, 0, H);
+        bandUs[1] = 0;
+        lastPassUs = bandUs[0];
+        #endif
+    }
+
+    // Barrier: wait for the worker's band of the current resample.
+    void finishResample() {
+        #if FEEDBACK_PARALLEL
+        if (!resamplePending) return;
+        worker.wait();
+        resamplePending = false;
+        lastPassUs = max(bandUs[0], bandUs[1]);
+        #endif
+    }
 
-        const CRGB* src = prev;
-        CRGB* dst = curr;
+    static void workerBand(void* self) {
+        VideoFeedback* fb = static_cast<VideoFeedback*>(self);
+        fb->resampleBand(1, fb->setup.split, H);
+    }
 
+    void resampleBand(uint8_t band, uint8_t y0, uint8_t y1) {
+        uint32_t t0 = micros();
+        if (setup.mesh) {
+            if (setup.swar) meshRows<true>(setup, y0, y1);
+            else meshRows<false>(setup, y0, y1);
+        } else {
+            #if FEEDBACK_WARP_CACHE
+            if (setup.swar) warpRows<true>(setup, y0, y1);
+            else warpRows<false>(setup, y0, y1);
+            #else
+            if (setup.swar) resampleRows<true>(setup, y0, y1);
+            else resampleRows<false>(setup, y0, y1);
+            #endif
+        }
+        bandUs[band] = micros() - t0;
+    }
+
+    // The transform is affine, so the source footprint's extremes are at
+    // the destination corners. When every tap of every pixel (x0..x0+1,
+    // y0..y0+1) falls inside the image + guard, no pixel needs a fold or a
+    // bounds check. Typical presets (zoom within a few percent of 1, small
+    // rotation and drift) stay inside.
+    static bool footprintInGuard(const ResampleSetup& rs) {
+        int32_t minX = INT32_MAX, maxX = INT32_MIN, minY = INT32_MAX, maxY = INT32_MIN;
+        for (uint8_t corner = 0; corner < 4; corner++) {
+            const int32_t x = (corner & 1) ? W - 1 : 0;
+            const int32_t y = (corner & 2) ? H - 1 : 0;
+            const int32_t sx = rs.sx00 + x * rs.dxCol + y * rs.dxRow;
+            const int32_t sy = rs.sy00 + x * rs.dyCol + y * rs.dyRow;
+            if (sx < minX) minX = sx;
+            if (sx > maxX) maxX = sx;
+            if (sy < minY) minY = sy;
+            if (sy > maxY) maxY = sy;
+        }
+        return (minX >> 16) >= -GUARD && (maxX >> 16) <= W + GUARD - 2 &&
+               (minY >> 16) >= -GUARD && (maxY >> 16) <= H + GUARD - 2;
+    }
+
+    // Refill the border of the buffer whose pixel (0, 0) is at `img`.
+    static void refreshGuard(CRGB* img, bool wrap) {
         for (uint8_t y = 0; y < H; y++) {
+            CRGB* row = img + (uint16_t)y * STRIDE;
+            for (uint8_t g = 1; g <= GUARD; g++) {
+                row[-g] = wrap ? row[W - g] : CRGB::Black;
+                row[W - 1 + g] = wrap ? row[g - 1] : CRGB::Black;
+            }
+        }
+        // Whole padded rows, so the corners follow the columns just filled.
+        for (uint8_t g = 1; g <= GUARD; g++) {
+            CRGB* above = img - (int)g * STRIDE - GUARD;
+            CRGB* below = img + (H - 1 + g) * STRIDE - GUARD;
+            if (wrap) {
+                memcpy(above, img + (H - g) * STRIDE - GUARD, STRIDE * sizeof(CRGB));
+                memcpy(below, img + (g - 1) * STRIDE - GUARD, STRIDE * sizeof(CRGB));
+            } else {
+                fill_solid(above, STRIDE, CRGB::Black);
+                fill_solid(below, STRIDE, CRGB::Black);
+            }
+        }
+    }
+
+    // Footprint of 16.16 source position (wx, wy), whose four taps must lie
+    // within the image + guard. Same bilinear weights as the Wu splat in
+    // Canvas::drawPixelF.
+    static WarpTap makeTap(int32_t wx, int32_t wy) {
+        const int16_t x0 = (int16_t)(wx >> 16);
+        const int16_t y0 = (int16_t)(wy >> 16);
+        const uint8_t xf = (wx >> 8) & 0xFF;
+        const uint8_t yf = (wy >> 8) & 0xFF;
+        const uint8_t ixf = 255 - xf, iyf = 255 - yf;
+
+        WarpTap t;
+        t.index = (uint16_t)((y0 + GUARD) * STRIDE + x0 + GUARD);
+        t.w00 = FB_WU_WEIGHT(ixf, iyf);
+        t.w10 = FB_WU_WEIGHT(xf, iyf);
+        t.w01 = FB_WU_WEIGHT(ixf, yf);
+        t.w11 = FB_WU_WEIGHT(xf, yf);
+        return t;
+    }
+
+    // Blend the footprint t in the padded buffer buf; attenuate by eff into
+    // *dst.
+    static void blendTap(const CRGB* buf, const WarpTap& t, uint8_t eff, CRGB* dst) {
+        const CRGB* p0 = buf + t.index;
+        const CRGB* p1 = p0 + STRIDE;
+        const uint16_t r = p0[0].r * t.w00 + p0[1].r * t.w10 + p1[0].r * t.w01 + p1[1].r * t.w11;
+        const uint16_t g = p0[0].g * t.w00 + p0[1].g * t.w10 + p1[0].g * t.w01 + p1[1].g * t.w11;
+        const uint16_t b = p0[0].b * t.w00 + p0[1].b * t.w10 + p1[0].b * t.w01 + p1[1].b * t.w11;
+
+        dst->r = scale8((uint8_t)(r >> 8), eff);
+        dst->g = scale8((uint8_t)(g >> 8), eff);
+        dst->b = scale8((uint8_t)(b >> 8), eff);
+    }
+
+    // Copy a whole padded buffer into 0x00BBGGRR words.
+    static void packRgbx(const CRGB* buf, uint32_t* out) {
+        for (uint16_t i = 0; i < STRIDE * PADDED_H; i++) {
+            out[i] = buf[i].r | ((uint32_t)buf[i].g << 8) | ((uint32_t)buf[i].b << 16);
+        }
+    }
+
+    // blendTap() on the RGBx copy. Red and blue sit in separate 16-bit
+    // halves of (p & 0x00FF00FF), so one multiply weights both and the four
+    // taps accumulate without carrying across: the weights sum to at most
+    // 257, so a half peaks at 255 * 257 = 65535 - exactly the range of the
+    // reference kernel's uint16_t sums. Green goes through the low half of
+    // (p >> 8). The decay is one more multiply per pair, written out as
+    // FastLED's scale8().
+    static void blendTapRgbx(const uint32_t* buf, const WarpTap& t, uint8_t eff, CRGB* dst) {
+        const uint32_t* p0 = buf + t.index;
+        const uint32_t* p1 = p0 + STRIDE;
+        const uint32_t a = p0[0], b = p0[1], c = p1[0], d = p1[1];
+        const uint32_t w00 = t.w00, w10 = t.w10, w01 = t.w01, w11 = t.w11;
+        const uint32_t RB = 0x00FF00FF;
+        uint32_t rb = (a & RB) * w00 + (b & RB) * w10 + (c & RB) * w01 + (d & RB) * w11;
+        uint32_t g = (a >> 8 & 0xFF) * w00 + (b >> 8 & 0xFF) * w10 +
+                     (c >> 8 & 0xFF) * w01 + (d >> 8 & 0xFF) * w11;
+
+        #if FASTLED_SCALE8_FIXED
+        const uint32_t scale = (uint32_t)eff + 1;
+        #else
+        const uint32_t scale = eff;
+        #endif
+        rb = ((rb >> 8 & RB) * scale) >> 8;
+        g = ((g >> 8) * scale) >> 8;
+
+        dst->r = (uint8_t)rb;
+        dst->g = (uint8_t)g;
+        dst->b = (uint8_t)(rb >> 16);
+    }
+
+    // Footprint of a source position anywhere. Inside the guard it is used
+    // as is - the border holds the wrapped pixels or black. Beyond it, wrap
+    // mode folds the position into the image; with clamping both taps of
+    // one axis are outside the image, so the pixel is black: zero weights.
+    static WarpTap footprint(bool wrap, int32_t wx, int32_t wy) {
+        const int32_t x0 = wx >> 16, y0 = wy >> 16;
+        if (x0 < -GUARD || x0 > W + GUARD - 2 || y0 < -GUARD || y0 > H + GUARD - 2) {
+            if (!wrap) {
+                const WarpTap black = {ORIGIN, 0, 0, 0, 0};
+                return black;
+            }
+            const int32_t WFP = (int32_t)W << 16;
+            const int32_t HFP = (int32_t)H << 16;
+            wx %= WFP; if (wx < 0) wx += WFP;
+            wy %= HFP; if (wy < 0) wy += HFP;
+        }
+        return makeTap(wx, wy);
+    }
+
+    // Blend with the kernel chosen for this resample.
+    template <bool SWAR>
+    static void blend(const ResampleSetup& rs, const WarpTap& t, CRGB* dst) {
+        if (SWAR) blendTapRgbx(rs.srcRgbx, t, rs.eff, dst);
+        else blendTap(rs.srcBuf, t, rs.eff, dst);
+    }
+
+    // Resample destination rows [yBegin, yEnd).
+    //
+    // Footprint inside the guard: one unchecked loop for both modes - the
+    // border holds the wrapped pixels or black. Otherwise wrap mode folds
+    // each position into the image first (x0 + 1 / y0 + 1 then land in the
+    // border), and clamp mode tests each tap. SWAR picks the RGBx kernel for
+    // the unchecked loops. MAP also records every footprint in rs.map; its
+    // clamp loop uses footprint(), which is black wherever sampleClamped()
+    // would find no tap inside the image.
+    template <bool SWAR, bool MAP = false>
+    static void resampleRows(const ResampleSetup& rs, uint8_t yBegin, uint8_t yEnd) {
+        const int32_t WFP = (int32_t)W << 16;
+        const int32_t HFP = (int32_t)H << 16;
+        const int32_t dxCol = rs.dxCol, dyCol = rs.dyCol;
+
+        int32_t rowSx = rs.sx00 + (int32_t)yBegin * rs.dxRow;
+        int32_t rowSy = rs.sy00 + (int32_t)yBegin * rs.dyRow;
+
+        for (uint8_t y = yBegin; y < yEnd; y++) {
+            CRGB* dst = rs.dst + (uint16_t)y * STRIDE;
+            WarpTap* taps = MAP ? rs.map + (uint16_t)y * W : nullptr;
             int32_t sx = rowSx, sy = rowSy;
-            for (uint8_t x = 0; x < W; x++, dst++) {
-                int32_t wx = sx, wy = sy;
-                if (wrap) {
-                    wx %= WFP; if (wx < 0) wx += WFP;
-                    wy %= HFP; if (wy < 0) wy += HFP;
-                }
 
-                int16_t x0 = (int16_t)(wx >> 16);
-                int16_t y0 = (int16_t)(wy >> 16);
-                uint8_t xf = (wx >> 8) & 0xFF;
-                uint8_t yf = (wy >> 8) & 0xFF;
-                uint8_t ixf = 255 - xf, iyf = 255 - yf;
-
-                // Same bilinear weights as the Wu splat in Canvas::drawPixelF.
-                uint8_t w00 = FB_WU_WEIGHT(ixf, iyf);
-                uint8_t w10 = FB_WU_WEIGHT(xf, iyf);
-                uint8_t w01 = FB_WU_WEIGHT(ixf, yf);
-                uint8_t w11 = FB_WU_WEIGHT(xf, yf);
-
-                uint16_t r = 0, g = 0, b = 0;
-
-                if (wrap) {
-                    int16_t x1 = x0 + 1; if (x1 >= W) x1 = 0;
-                    int16_t y1 = y0 + 1; if (y1 >= H) y1 = 0;
-                    const CRGB& p00 = src[(uint16_t)y0 * W + x0];
-                    const CRGB& p10 = src[(uint16_t)y0 * W + x1];
-                    const CRGB& p01 = src[(uint16_t)y1 * W + x0];
-                    const CRGB& p11 = src[(uint16_t)y1 * W + x1];
-                    r = p00.r * w00 + p10.r * w10 + p01.r * w01 + p11.r * w11;
-                    g = p00.g * w00 + p10.g * w10 + p01.g * w01 + p11.g * w11;
-                    b = p00.b * w00 + p10.b * w10 + p01.b * w01 + p11.b * w11;
-                } else {
-                    // Clamp-to-black: out-of-bounds taps contribute nothing.
-                    int16_t x1 = x0 + 1, y1 = y0 + 1;
-                    bool vx0 = (x0 >= 0 && x0 < W), vx1 = (x1 >= 0 && x1 < W);
-                    bool vy0 = (y0 >= 0 && y0 < H), vy1 = (y1 >= 0 && y1 < H);
-                    if (vy0) {
-                        if (vx0) { const CRGB& p = src[(uint16_t)y0 * W + x0]; r += p.r * w00; g += p.g * w00; b += p.b * w00; }
-                        if (vx1) { const CRGB& p = src[(uint16_t)y0 * W + x1]; r += p.r * w10; g += p.g * w10; b += p.b * w10; }
-                    }
-                    if (vy1) {
-                        if (vx0) { const CRGB& p = src[(uint16_t)y1 * W + x0]; r += p.r * w01; g += p.g * w01; b += p.b * w01; }
-                        if (vx1) { const CRGB& p = src[(uint16_t)y1 * W + x1]; r += p.r * w11; g += p.g * w11; b += p.b * w11; }
-                    }
+            if (rs.inGuard) {
+                for (uint8_t x = 0; x < W; x++, sx += dxCol, sy += dyCol) {
+                    const WarpTap t = makeTap(sx, sy);
+                    if (MAP) taps[x] = t;
+                    blend<SWAR>(rs, t, dst + x);
+                }
+            } else if (rs.wrap) {
+                for (uint8_t x = 0; x < W; x++, sx += dxCol, sy += dyCol) {
+                    int32_t wx = sx % WFP; if (wx < 0) wx += WFP;
+                    int32_t wy = sy % HFP; if (wy < 0) wy += HFP;
+                    const WarpTap t = makeTap(wx, wy);
+                    if (MAP) taps[x] = t;
+                    blend<SWAR>(rs, t, dst + x);
+                }
+            } else if (MAP) {
+                for (uint8_t x = 0; x < W; x++, sx += dxCol, sy += dyCol) {
+                    const WarpTap t = footprint(false, sx, sy);
+                    taps[x] = t;
+                    blend<SWAR>(rs, t, dst + x);
+                }
+            } else {
+                for (uint8_t x = 0; x < W; x++, sx += dxCol, sy += dyCol) {
+                    sampleClamped(rs.src, sx, sy, rs.eff, dst + x);
                 }
+            }
+            rowSx += rs.dxRow;
+            rowSy += rs.dyRow;
+        }
+    }
 
-                dst->r = scale8((uint8_t)(r >> 8), eff);
-                dst->g = scale8((uint8_t)(g >> 8), eff);
-                dst->b = scale8((uint8_t)(b >> 8), eff);
+    #if FEEDBACK_WARP_CACHE
+    // Round each transform term to a multiple of 2^bits.
+    static void quantizeTransform(ResampleSetup& rs, uint8_t bits) {
+        if (bits == 0) return;
+        const int32_t half = (int32_t)1 << (bits - 1);
+        const int32_t mask = ~((half << 1) - 1);
+        rs.sx00 = (rs.sx00 + half) & mask;
+        rs.sy00 = (rs.sy00 + half) & mask;
+        rs.dxCol = (rs.dxCol + half) & mask;
+        rs.dyCol = (rs.dyCol + half) & mask;
+        rs.dxRow = (rs.dxRow + half) & mask;
+        rs.dyRow = (rs.dyRow + half) & mask;
+    }
 
-                sx += dxCol;
-                sy += dyCol;
-            }
-            rowSx += dxRow;
-            rowSy += dyRow;
+    // Same transform (and edge mode) as the one the warp map was built for.
+    static bool sameTransform(const ResampleSetup& a, const ResampleSetup& b) {
+        return a.sx00 == b.sx00 && a.sy00 == b.sy00 &&
+               a.dxCol == b.dxCol && a.dyCol == b.dyCol &&
+               a.dxRow == b.dxRow && a.dyRow == b.dyRow && a.wrap == b.wrap;
+    }
+
+    // Resample destination rows [yBegin, yEnd) through the warp map, or,
+    // when it is out of date, with resampleRows() recording it on the way.
+    template <bool SWAR>
+    static void warpRows(const ResampleSetup& rs, uint8_t yBegin, uint8_t yEnd) {
+        if (rs.buildMap) {
+            resampleRows<SWAR, true>(rs, yBegin, yEnd);
+            return;
+        }
+        for (uint8_t y = yBegin; y < yEnd; y++) {
+            CRGB* dst = rs.dst + (uint16_t)y * STRIDE;
+            const WarpTap* taps = rs.map + (uint16_t)y * W;
+            for (uint8_t x = 0; x < W; x++) blend<SWAR>(rs, taps[x], dst + x);
+        }
+    }
+    #endif
+
+    // Resample destination rows [yBegin, yEnd) at the warp mesh's source
+    // positions.
+    template <bool SWAR>
+    static void meshRows(const ResampleSetup& rs, uint8_t yBegin, uint8_t yEnd) {
+        int32_t xs[W], ys[W];
+        for (uint8_t y = yBegin; y < yEnd; y++) {
+            CRGB* dst = rs.dst + (uint16_t)y * STRIDE;
+            rs.mesh->row(y, xs, ys);
+            for (uint8_t x = 0; x < W; x++) blend<SWAR>(rs, footprint(rs.wrap, xs[x], ys[x]), dst + x);
         }
     }
+
+    // Clamp-to-black sample for positions anywhere: out-of-bounds taps
+    // contribute nothing.
+    static void sampleClamped(const CRGB* src, int32_t wx, int32_t wy, uint8_t eff, CRGB* dst) {
+        const int16_t x0 = (int16_t)(wx >> 16);
+        const int16_t y0 = (int16_t)(wy >> 16);
+        const uint8_t xf = (wx >> 8) & 0xFF;
+        const uint8_t yf = (wy >> 8) & 0xFF;
+        const uint8_t ixf = 255 - xf, iyf = 255 - yf;
+
+        const uint8_t w00 = FB_WU_WEIGHT(ixf, iyf);
+        const uint8_t w10 = FB_WU_WEIGHT(xf, iyf);
+        const uint8_t w01 = FB_WU_WEIGHT(ixf, yf);
+        const uint8_t w11 = FB_WU_WEIGHT(xf, yf);
+
+        uint16_t r = 0, g = 0, b = 0;
+        const int16_t x1 = x0 + 1, y1 = y0 + 1;
+        const bool vx0 = (x0 >= 0 && x0 < W), vx1 = (x1 >= 0 && x1 < W);
+        const bool vy0 = (y0 >= 0 && y0 < H), vy1 = (y1 >= 0 && y1 < H);
+        if (vy0) {
+            if (vx0) { const CRGB& p = src[(uint16_t)y0 * STRIDE + x0]; r += p.r * w00; g += p.g * w00; b += p.b * w00; }
+            if (vx1) { const CRGB& p = src[(uint16_t)y0 * STRIDE + x1]; r += p.r * w10; g += p.g * w10; b += p.b * w10; }
+        }
+        if (vy1) {
+            if (vx0) { const CRGB& p = src[(uint16_t)y1 * STRIDE + x0]; r += p.r * w01; g += p.g * w01; b += p.b * w01; }
+            if (vx1) { const CRGB& p = src[(uint16_t)y1 * STRIDE + x1]; r += p.r * w11; g += p.g * w11; b += p.b * w11; }
+        }
+
+        dst->r = scale8((uint8_t)(r >> 8), eff);
+        dst->g = scale8((uint8_t)(g >> 8), eff);
+        dst->b = scale8((uint8_t)(b >> 8), eff);
+    }
+
+    ResampleSetup setup;
+    uint32_t bandUs[BANDS] = {0, 0};
+    #if FEEDBACK_WARP_CACHE
+    WarpTap warpMap[W * H];
+    ResampleSetup warpKey; // transform warpMap was built for
+    bool warpValid = false;
+    #endif
+    #if FEEDBACK_PARALLEL
+    CoreWorker worker{FEEDBACK_WORKER_CORE};
+    bool resamplePending = false;
+    #endif
 };
 
 #endif // FEEDBACK_H
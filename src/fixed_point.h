@@ -0,0 +1,149 @@
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <Arduino.h>
+#include "lookup_tables.h"
+
+// ---------------------------------------------------------------------------
+// Fixed<FRAC>: signed fixed-point scalar with FRAC fractional bits, stored in
+// an int32_t (Fixed<16> is Q16.16, Fixed<8> is Q24.8 - Q8.8 precision with
+// headroom for squared distances on the 48x48 world).
+//
+// Every operation is plain integer math with 64-bit intermediates, so results
+// are bit-identical on the ESP32-S3 and on a host build regardless of FPU,
+// FMA contraction or libm. Multiply, divide and add saturate instead of
+// wrapping: attractor forces can spike far past the representable range when
+// a boid sits on top of a heavy attractor, and a clamped force behaves much
+// better than one that wraps to the opposite sign.
+//
+// Conversions from float truncate toward zero; conversions to float are exact
+// while |value| < 2^(24 - FRAC) (256 for Q16.16).
+// ---------------------------------------------------------------------------
+template <int FRAC>
+class Fixed {
+public:
+    static const int32_t ONE = (int32_t)1 << FRAC;
+    int32_t raw;
+
+    Fixed() : raw(0) {}
+
+    static Fixed fromRaw(int32_t r) { Fixed f; f.raw = r; return f; }
+    static Fixed fromInt(int32_t i) { return fromRaw(saturate((int64_t)i * ONE)); }
+    static Fixed fromFloat(float v) {
+        float scaled = v * (float)ONE;
+        if (scaled >= 2147483520.0f) return fromRaw(INT32_MAX);
+        if (scaled <= -2147483648.0f) return fromRaw(INT32_MIN);
+        return fromRaw((int32_t)scaled);
+    }
+
+    float toFloat() const { return (float)raw * (1.0f / (float)ONE); }
+    int32_t toInt() const { return raw / ONE; }
+
+    Fixed operator-() const { return fromRaw(saturate(-(int64_t)raw)); }
+    Fixed operator+(Fixed o) const { return fromRaw(saturate((int64_t)raw + o.raw)); }
+    Fixed operator-(Fixed o) const { return fromRaw(saturate((int64_t)raw - o.raw)); }
+    Fixed operator*(Fixed o) const { return fromRaw(saturate(((int64_t)raw * o.raw) >> FRAC)); }
+    Fixed operator/(Fixed o) const {
+        if (o.raw == 0) return fromRaw(raw >= 0 ? INT32_MAX : INT32_MIN);
+        return fromRaw(saturate(((int64_t)raw * ONE) / o.raw));
+    }
+
+    Fixed& operator+=(Fixed o) { return *this = *this + o; }
+    Fixed& operator-=(Fixed o) { return *this = *this - o; }
+    Fixed& operator*=(Fixed o) { return *this = *this * o; }
+    Fixed& operator/=(Fixed o) { return *this = *this / o; }
+
+    bool operator==(Fixed o) const { return raw == o.raw; }
+    bool operator!=(Fixed o) const { return raw != o.raw; }
+    bool operator<(Fixed o) const { return raw < o.raw; }
+    bool operator>(Fixed o) const { return raw > o.raw; }
+    bool operator<=(Fixed o) const { return raw <= o.raw; }
+    bool operator>=(Fixed o) const { return raw >= o.raw; }
+
+    static int32_t saturate(int64_t v) {
+        if (v > INT32_MAX) return INT32_MAX;
+        if (v < INT32_MIN) return INT32_MIN;
+        return (int32_t)v;
+    }
+};
+
+// Exact square root (rounded down to the nearest representable value).
+template <int FRAC>
+inline Fixed<FRAC> fixedSqrt(Fixed<FRAC> v) {
+    if (v.raw <= 0) return Fixed<FRAC>();
+    // sqrt(raw / 2^F) * 2^F == sqrt(raw * 2^F)
+    uint64_t n = (uint64_t)v.raw << FRAC;
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while (bit > n) bit >>= 2;
+    while (bit) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return Fixed<FRAC>::fromRaw((int32_t)root);
+}
+
+// Fixed-point twin of fastSqrt(): same table, same index, so fixed-point
+// physics keeps the float path's distance scale (and therefore its look).
+template <int FRAC>
+inline Fixed<FRAC> fixedFastSqrt(Fixed<FRAC> v) {
+    if (v.raw <= 0) return Fixed<FRAC>();
+    if (v.raw >= (int64_t)SQRT_TABLE_RANGE * Fixed<FRAC>::ONE) return fixedSqrt(v);
+    int32_t index = (int32_t)(((int64_t)v.raw * (SQRT_TABLE_SIZE - 1)) >> FRAC) / SQRT_TABLE_RANGE;
+    return Fixed<FRAC>::fromFloat(pgm_read_float(&sqrtTable[index]));
+}
+
+// ---------------------------------------------------------------------------
+// FixedVec2: the subset of vec2 the boid physics uses, on Fixed components.
+// length()/normalize()/limit() follow vec2 step for step (including the
+// table-based length), so the two backends produce the same motion up to
+// rounding.
+// ---------------------------------------------------------------------------
+template <int FRAC>
+class FixedVec2 {
+public:
+    typedef Fixed<FRAC> Scalar;
+    Scalar x, y;
+
+    FixedVec2() {}
+    FixedVec2(Scalar x, Scalar y) : x(x), y(y) {}
+
+    static FixedVec2 fromFloat(float fx, float fy) {
+        return FixedVec2(Scalar::fromFloat(fx), Scalar::fromFloat(fy));
+    }
+
+    FixedVec2 operator+(FixedVec2 v) const { return FixedVec2(x + v.x, y + v.y); }
+    FixedVec2 operator-(FixedVec2 v) const { return FixedVec2(x - v.x, y - v.y); }
+    FixedVec2 operator*(Scalar s) const { return FixedVec2(x * s, y * s); }
+    FixedVec2 operator/(Scalar s) const { return FixedVec2(x / s, y / s); }
+    FixedVec2& operator+=(FixedVec2 v) { x += v.x; y += v.y; return *this; }
+    FixedVec2& operator-=(FixedVec2 v) { x -= v.x; y -= v.y; return *this; }
+    FixedVec2& operator*=(Scalar s) { x *= s; y *= s; return *this; }
+    FixedVec2& operator/=(Scalar s) { x /= s; y /= s; return *this; }
+
+    Scalar magSq() const { return x * x + y * y; }
+    Scalar length() const { return fixedFastSqrt(magSq()); }
+
+    FixedVec2& normalize() {
+        Scalar len = length();
+        if (len.raw == 0) return *this;
+        *this *= Scalar::fromInt(1) / len;
+        return *this;
+    }
+
+    void limit(Scalar max) {
+        if (magSq() > max * max) {
+            normalize();
+            *this *= max;
+        }
+    }
+
+    FixedVec2 ortho() const { return FixedVec2(y, -x); }
+};
+
+#endif // FIXED_POINT_H
@@ -0,0 +1,137 @@
+#ifndef HDR_ACCUMULATOR_H
+#define HDR_ACCUMULATOR_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include "config.h"
+
+// Tone map HdrAccumulator::resolve() starts with: 0 = clip, 1 = soft knee,
+// 2 = auto exposure (see ToneMap).
+#ifndef CANVAS_HDR_TONEMAP
+#define CANVAS_HDR_TONEMAP 1
+#endif
+
+enum ToneMap : uint8_t {
+    TONEMAP_CLIP = 0,      // saturate at 255 - same pixels as per-splat qadd8
+    TONEMAP_SOFT_KNEE,     // linear up to the knee, then rolls off toward 255
+    TONEMAP_AUTO_EXPOSURE, // scale new light down when a frame overexposes
+    TONEMAP_COUNT
+};
+
+// ---------------------------------------------------------------------------
+// HdrAccumulator: 16-bit-per-channel additive light for one frame.
+//
+// Additive draws (Wu splats, blendPixel) add into 16-bit channels with plain
+// adds instead of saturating every contribution at 8 bits. resolve() then
+// merges the accumulated light into the 8-bit buffer once, through the
+// selected tone map, and clears what it consumed.
+//
+// Only pixels that received light are touched at resolve, so the persistent
+// 8-bit image (trails, fades) is left exactly as it was everywhere else.
+// A splat adds at most 255 per channel in total across its four pixels, so a
+// pixel can take 257 full-brightness points per frame before wrapping; the
+// full 254-boid flock stacked on one pixel stays in range.
+// ---------------------------------------------------------------------------
+class HdrAccumulator {
+public:
+    ToneMap toneMap = (ToneMap)CANVAS_HDR_TONEMAP;
+
+    // Soft knee: values up to `knee` pass through, above it the curve has
+    // slope 1 at the knee and approaches 255 asymptotically.
+    uint8_t knee = 192;
+
+    // Auto exposure: gain (8.8 fixed point, 256 = 1.0) applied to the new
+    // light, and the brightest channel of the last resolved frame.
+    uint16_t exposure = 256;
+    uint32_t peak = 0;
+
+    bool pending() const { return dirty; }
+
+    // Add color * weight / 256 at buffer index i.
+    void add(uint16_t i, CRGB color, uint8_t weight) {
+        Accum& a = acc[i];
+        a.r += (color.r * weight) >> 8;
+        a.g += (color.g * weight) >> 8;
+        a.b += (color.b * weight) >> 8;
+        dirty = true;
+    }
+
+    // Add the full color at buffer index i.
+    void add(uint16_t i, CRGB color) {
+        Accum& a = acc[i];
+        a.r += color.r;
+        a.g += color.g;
+        a.b += color.b;
+        dirty = true;
+    }
+
+    // Drop any accumulated light without applying it.
+    void discard() {
+        if (!dirty) return;
+        memset(acc, 0, sizeof(acc));
+        dirty = false;
+    }
+
+    // Merge the accumulated light into leds[0, count) and clear it.
+    void resolve(CRGB* leds, int count) {
+        if (!dirty) return;
+        uint32_t framePeak = 0;
+        for (int i = 0; i < count; i++) {
+            Accum& a = acc[i];
+            if (!(a.r | a.g | a.b)) continue;
+
+            CRGB& px = leds[i];
+            uint32_t r = a.r, g = a.g, b = a.b;
+            if (toneMap == TONEMAP_AUTO_EXPOSURE) {
+                uint32_t hi = max(px.r + r, max(px.g + g, px.b + b));
+                if (hi > framePeak) framePeak = hi;
+                r = (r * exposure) >> 8;
+                g = (g * exposure) >> 8;
+                b = (b * exposure) >> 8;
+            }
+            r += px.r;
+            g += px.g;
+            b += px.b;
+
+            if (toneMap == TONEMAP_SOFT_KNEE) {
+                px.r = softKnee(r);
+                px.g = softKnee(g);
+                px.b = softKnee(b);
+            } else {
+                px.r = r > 255 ? 255 : r;
+                px.g = g > 255 ? 255 : g;
+                px.b = b > 255 ? 255 : b;
+            }
+            a.r = a.g = a.b = 0;
+        }
+        dirty = false;
+        if (toneMap == TONEMAP_AUTO_EXPOSURE) adaptExposure(framePeak);
+    }
+
+private:
+    struct Accum {
+        uint16_t r, g, b;
+    };
+
+    uint8_t softKnee(uint32_t v) const {
+        if (v <= knee) return v;
+        const uint32_t room = 255 - knee;
+        const uint32_t over = v - knee;
+        return knee + (over * room) / (over + room);
+    }
+
+    // Move the exposure 1/8 of the way toward the gain that would have fit
+    // this frame's peak into 255 (never above 1.0, never below 1/16).
+    void adaptExposure(uint32_t framePeak) {
+        peak = framePeak;
+        int target = framePeak > 255 ? (int)((255u << 8) / framePeak) : 256;
+        if (target < 16) target = 16;
+        int step = (target - (int)exposure) / 8;
+        exposure = step ? exposure + step : target;
+    }
+
+    Accum acc[ROWS * COLS] = {};
+    bool dirty = false;
+};
+
+#endif // HDR_ACCUMULATOR_H
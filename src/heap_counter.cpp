@@ -0,0 +1,56 @@
+#include "heap_counter.h"
+
+#if DEBUG_HEAP_COUNTER
+
+#include <new>
+#include <stdlib.h>
+
+// Plain counters: a torn read while another task allocates only skews one
+// log line, which is not worth an atomic on every allocation.
+static volatile uint32_t allocCount = 0;
+static volatile uint32_t freeCount = 0;
+
+uint32_t heapAllocCount() { return allocCount; }
+uint32_t heapFreeCount() { return freeCount; }
+
+static void* countedAlloc(size_t size) {
+    allocCount = allocCount + 1;
+    return malloc(size ? size : 1);
+}
+
+// The throwing forms: on failure call the new-handler and retry, as the
+// standard operator new does; with no handler installed, throw bad_alloc
+// (or abort when built without exceptions).
+static void* countedAllocOrThrow(size_t size) {
+    for (;;) {
+        void* p = countedAlloc(size);
+        if (p) return p;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            #if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+            throw std::bad_alloc();
+            #else
+            abort();
+            #endif
+        }
+        handler();
+    }
+}
+
+static void countedFree(void* p) {
+    if (!p) return;
+    freeCount = freeCount + 1;
+    free(p);
+}
+
+void* operator new(size_t size) { return countedAllocOrThrow(size); }
+void* operator new[](size_t size) { return countedAllocOrThrow(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+
+void operator delete(void* p) noexcept { countedFree(p); }
+void operator delete[](void* p) noexcept { countedFree(p); }
+void operator delete(void* p, size_t) noexcept { countedFree(p); }
+void operator delete[](void* p, size_t) noexcept { countedFree(p); }
+
+#endif // DEBUG_HEAP_COUNTER
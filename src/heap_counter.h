@@ -0,0 +1,31 @@
+#ifndef HEAP_COUNTER_H
+#define HEAP_COUNTER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// ---------------------------------------------------------------------------
+// Heap allocation counter (debug builds only).
+//
+// With DEBUG_HEAP_COUNTER enabled, heap_counter.cpp replaces the global
+// operator new/delete with thin wrappers around malloc/free that bump a pair
+// of counters. Snapshot heapAllocCount() before and after a region to see how
+// many allocations it made; the EffectManager does this around every frame.
+//
+// Only C++ allocations are counted. Direct malloc() calls (e.g. from the
+// Arduino core or ESP-IDF) bypass operator new and are not seen here.
+// ---------------------------------------------------------------------------
+
+#if DEBUG_HEAP_COUNTER
+
+uint32_t heapAllocCount();
+uint32_t heapFreeCount();
+
+#else
+
+inline uint32_t heapAllocCount() { return 0; }
+inline uint32_t heapFreeCount() { return 0; }
+
+#endif
+
+#endif // HEAP_COUNTER_H
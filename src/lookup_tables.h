@@ -91,6 +91,11 @@ inline float fastCos(uint8_t angle) {
     return pgm_read_float(&sinTable[((angle + (SIN_TABLE_SIZE / 4)) & (SIN_TABLE_SIZE - 1))]);
 }
 
+// Table slot fastSqrt() reads for 0 < value < SQRT_TABLE_RANGE.
+inline uint16_t fastSqrtIndex(float value) {
+    return (uint16_t)((value * (SQRT_TABLE_SIZE - 1)) / SQRT_TABLE_RANGE);
+}
+
 // Get square root from lookup table
 inline float fastSqrt(float value) {
     // Clamp the input value to the table range
@@ -101,25 +106,37 @@ inline float fastSqrt(float value) {
         return sqrt(value);
     }
     
-    // Scale the value to fit the table
-    uint16_t index = (uint16_t)((value * (SQRT_TABLE_SIZE - 1)) / SQRT_TABLE_RANGE);
-    
     // Get the table value
-    return pgm_read_float(&sqrtTable[index]);
+    return pgm_read_float(&sqrtTable[fastSqrtIndex(value)]);
+}
+
+// Smallest table index whose entry is >= limit (SQRT_TABLE_SIZE if none).
+// For 0 < value < SQRT_TABLE_RANGE this turns a distance test on squared
+// values into an integer compare with the exact same outcome:
+//   fastSqrt(value) < limit   <=>   fastSqrtIndex(value) < fastSqrtIndexBound(limit)
+// since the table is monotonic. Compute the bound once per radius, not per test.
+inline uint16_t fastSqrtIndexBound(float limit) {
+    uint16_t lo = 0, hi = SQRT_TABLE_SIZE;
+    while (lo < hi) {
+        uint16_t mid = (lo + hi) / 2;
+        if (pgm_read_float(&sqrtTable[mid]) >= limit) hi = mid;
+        else lo = mid + 1;
+    }
+    return lo;
 }
 
 // Fast inverse square root (Quake III algorithm)
 inline float fastInvSqrt(float number) {
     // Use the famous Quake III fast inverse square root
-    long i;
+    int32_t i;
     float x2, y;
     const float threehalfs = 1.5F;
     
     x2 = number * 0.5F;
     y = number;
-    i = *(long*)&y;                 // bit level conversion
+    memcpy(&i, &y, sizeof(i));      // bit level conversion (32-bit on any host)
     i = 0x5f3759df - (i >> 1);      // what is this magic number?
-    y = *(float*)&i;
+    memcpy(&y, &i, sizeof(y));
     y = y * (threehalfs - (x2 * y * y)); // first iteration
     // y = y * (threehalfs - (x2 * y * y)); // second iteration (can be removed)
     
@@ -16,6 +16,7 @@
 #include "matrix_effects.h"
 #include "effect.h"
 #include "effect_manager.h"
+#include "effect_bench.h"
 #include "effects/boids_effect.h"
 #include "effects/plasma_effect.h"
 #include "effects/fire_effect.h"
@@ -51,9 +52,10 @@ int bran = random(1.5F, 4.0F);
 
 // --- Shared services --------------------------------------------------------
 Canvas canvas(leds, ROWS, COLS);              // pixel-placement layer
-MatrixEffects overlay(ROWS, COLS, matrixXY);  // overlay FX layer
+MatrixEffects overlay(ROWS, COLS);            // overlay FX layer
 EffectContext context(canvas, overlay);       // services handed to each effect
 EffectManager manager(context);
+EffectBench bench(context);                   // per-effect frame-time benchmark
 
 // --- Effects ----------------------------------------------------------------
 // Each effect reports a suggestedDurationMs(), so the EffectManager rotates
@@ -126,6 +128,12 @@ void loop() {
     // Debug commands for the video feedback system:
     //   f = cycle to the next feedback preset
     //   0 = OFF, 1 = TUNNEL_IN, 2 = TUNNEL_OUT, 3 = SPIRAL, 4 = ECHO_DRIFT
+    //   b = toggle the boid flocking backend (three-pass / fused)
+    //   g = toggle the attractor force grid for the current pattern
+    //   B / J = benchmark every registered effect, print CSV / JSON
+    //   t = cycle the HDR tone map (CANVAS_HDR builds)
+    //   k = toggle the feedback bilinear kernel (reference / SWAR)
+    //   m = cycle the feedback warp mesh (OFF, RIPPLE, SWIRL, BULGE)
     while (Serial.available()) {
         char c = Serial.read();
         switch (c) {
@@ -135,6 +143,19 @@ void loop() {
             case '2': boidsEffect.feedback.setPreset(FEEDBACK_TUNNEL_OUT); break;
             case '3': boidsEffect.feedback.setPreset(FEEDBACK_SPIRAL); break;
             case '4': boidsEffect.feedback.setPreset(FEEDBACK_ECHO_DRIFT); break;
+            case 'b': boidsEffect.nextFlockingBackend(); break;
+            case 'g': boidsEffect.toggleAttractorGridForPattern(); break;
+            case 'B': bench.runSuite(manager, Serial, BENCH_CSV); break;
+            case 'J': bench.runSuite(manager, Serial, BENCH_JSON); break;
+            case 'm': boidsEffect.feedback.nextMesh(); break;
+            case 'k': boidsEffect.feedback.nextKernel(); break;
+            #if CANVAS_HDR
+            case 't':
+                canvas.setToneMap((ToneMap)((canvas.toneMap() + 1) % TONEMAP_COUNT));
+                Serial.print("[HDR] Tone map: ");
+                Serial.println((int)canvas.toneMap());
+                break;
+            #endif
         }
     }
     #endif
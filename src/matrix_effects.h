@@ -4,14 +4,16 @@
 #include <Arduino.h>
 #include <FastLED.h>
 #include <math.h>
+#include "canvas.h"
 
+// Shared overlay FX (ripples, color wash, starfield, Perlin noise, screen
+// shake). The overlays add light through Canvas::blendPixel(), so they
+// accumulate in 16 bits with CANVAS_HDR and only mark the rows they touch.
 class MatrixEffects {
 private:
     // Screen dimensions
     const uint8_t rows;
     const uint8_t cols;
-    // Function to map 2D coordinates to LED strip index
-    uint16_t (*xyFunc)(uint8_t, uint8_t);
     
     // Ripple effect parameters
     struct Ripple {
@@ -63,8 +65,7 @@ private:
     uint8_t perlinBrightness = 128;
 
 public:
-    MatrixEffects(uint8_t rows, uint8_t cols, uint16_t (*xyFunc)(uint8_t, uint8_t))
-        : rows(rows), cols(cols), xyFunc(xyFunc) {
+    MatrixEffects(uint8_t rows, uint8_t cols) : rows(rows), cols(cols) {
         // Initialize ripples
         for (uint8_t i = 0; i < MAX_RIPPLES; i++) {
             ripples[i].active = false;
@@ -95,11 +96,11 @@ public:
     }
 
     // Update and draw all active ripples
-    void updateRipples(CRGB* leds) {
+    void updateRipples(Canvas& canvas) {
         for (uint8_t i = 0; i < MAX_RIPPLES; i++) {
             if (ripples[i].active) {
                 // Draw the ripple
-                drawRipple(leds, ripples[i]);
+                drawRipple(canvas, ripples[i]);
                 
                 // Expand the ripple
                 ripples[i].radius++;
@@ -116,7 +117,7 @@ public:
     }
 
     // Draw a single ripple
-    void drawRipple(CRGB* leds, const Ripple& ripple) {
+    void drawRipple(Canvas& canvas, const Ripple& ripple) {
         // Draw a circle with the current radius
         for (int16_t y = 0; y < rows; y++) {
             for (int16_t x = 0; x < cols; x++) {
@@ -128,12 +129,9 @@ public:
                     // Calculate fade based on distance from exact radius
                     float fade = 1.0 - abs(distance - ripple.radius);
                     
-                    // Get the pixel index
-                    uint16_t pixelIndex = xyFunc(x, y);
-                    
                     // Add the ripple color to the existing pixel
                     CRGB rippleColor = CHSV(ripple.color, 240, ripple.intensity * fade);
-                    leds[pixelIndex] += rippleColor;
+                    canvas.blendPixel(x, y, rippleColor);
                 }
             }
         }
@@ -170,7 +168,7 @@ public:
     }
 
     // Update and draw color wash effect
-    void updateColorWash(CRGB* leds) {
+    void updateColorWash(Canvas& canvas) {
         if (!washActive) return;
         
         // Slowly change the base hue
@@ -195,11 +193,8 @@ public:
                         break;
                 }
                 
-                // Get the pixel index
-                uint16_t pixelIndex = xyFunc(x, y);
-                
                 // Apply a subtle color wash
-                leds[pixelIndex] += CHSV(washHue + hueOffset, 200, 40);
+                canvas.blendPixel(x, y, CHSV(washHue + hueOffset, 200, 40));
             }
         }
     }
@@ -226,7 +221,7 @@ public:
     }
 
     // Update and draw starfield
-    void updateStarfield(CRGB* leds) {
+    void updateStarfield(Canvas& canvas) {
         if (!starfieldActive) return;
         
         // Update and draw each star
@@ -260,18 +255,17 @@ public:
             }
             
             // Draw the star
-            uint16_t pixelIndex = xyFunc(stars[i].x, stars[i].y);
             // Stars are white/blue/yellow
             uint8_t starHue = random8(3);
             switch (starHue) {
                 case 0:
-                    leds[pixelIndex] += CRGB(stars[i].brightness, stars[i].brightness, stars[i].brightness); // White
+                    canvas.blendPixel(stars[i].x, stars[i].y, CRGB(stars[i].brightness, stars[i].brightness, stars[i].brightness)); // White
                     break;
                 case 1:
-                    leds[pixelIndex] += CRGB(stars[i].brightness/2, stars[i].brightness/2, stars[i].brightness); // Blueish
+                    canvas.blendPixel(stars[i].x, stars[i].y, CRGB(stars[i].brightness/2, stars[i].brightness/2, stars[i].brightness)); // Blueish
                     break;
                 case 2:
-                    leds[pixelIndex] += CRGB(stars[i].brightness, stars[i].brightness, stars[i].brightness/2); // Yellowish
+                    canvas.blendPixel(stars[i].x, stars[i].y, CRGB(stars[i].brightness, stars[i].brightness, stars[i].brightness/2)); // Yellowish
                     break;
             }
         }
@@ -404,7 +398,7 @@ public:
     }
     
     // Update and draw Perlin noise effect
-    void updatePerlinNoise(CRGB* leds) {
+    void updatePerlinNoise(Canvas& canvas) {
         if (!perlinActive) return;
         
         // Increment time value for animation
@@ -431,22 +425,19 @@ public:
                 // Create a color based on position and noise value
                 uint8_t hue = perlinHue + map(noiseValue * 255, 0, 255, 0, 32);
                 
-                // Get the pixel index
-                uint16_t pixelIndex = xyFunc(x, y);
-                
                 // Apply color based on noise
-                leds[pixelIndex] += CHSV(hue, 240, brightness);
+                canvas.blendPixel(x, y, CHSV(hue, 240, brightness));
             }
         }
     }
     
     // Main update function - applies all active effects
-    void update(CRGB* leds) {
+    void update(Canvas& canvas) {
         // Update all active effects
-        updateRipples(leds);
-        updateColorWash(leds);
-        updateStarfield(leds);
-        updatePerlinNoise(leds);
+        updateRipples(canvas);
+        updateColorWash(canvas);
+        updateStarfield(canvas);
+        updatePerlinNoise(canvas);
         updateScreenShake();
     }
 
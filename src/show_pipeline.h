@@ -0,0 +1,164 @@
+#ifndef SHOW_PIPELINE_H
+#define SHOW_PIPELINE_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include <atomic>
+#include "config.h"
+
+#if !defined(ESP32)
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+// Core and priority of the LED sender task (ESP32). loop() runs on core 1,
+// so the sender defaults to core 0.
+#ifndef SHOW_PIPELINE_CORE
+#define SHOW_PIPELINE_CORE 0
+#endif
+#ifndef SHOW_PIPELINE_PRIORITY
+#define SHOW_PIPELINE_PRIORITY 2
+#endif
+
+// ---------------------------------------------------------------------------
+// ShowPipeline: FastLED.show() on a second core, overlapped with rendering.
+//
+// Two strip-ordered frame buffers and one single-producer/single-consumer
+// slot. The render side copies a finished frame into the back buffer,
+// publishes it in the slot and goes on to render the next frame, while the
+// sender - a FreeRTOS task pinned to SHOW_PIPELINE_CORE, or a std::thread on
+// a host build - takes it from the slot, points the FastLED controller at it
+// and transmits it.
+//
+// The sender empties the slot when it takes a frame, and by then it has
+// finished transmitting the buffer it used before. So once the slot is empty
+// the back buffer is free, and acquire() only waits while the sender is
+// still busy with the frame before last. No frame is dropped or sent twice.
+// ---------------------------------------------------------------------------
+class ShowPipeline {
+public:
+    ~ShowPipeline() { end(); }
+
+    // The back buffer, once the sender no longer needs it. Starts the sender
+    // on first use (after setup() has registered the controller).
+    CRGB* acquire() {
+        if (!started) begin();
+        uint32_t start = micros();
+        while (slot.load(std::memory_order_acquire) != EMPTY) waitForSender();
+        waitMicros += micros() - start;
+        return buffers[back];
+    }
+
+    // Hand the back buffer (filled after acquire()) to the sender.
+    void publish() {
+        slot.store((int8_t)back, std::memory_order_release);
+        back ^= 1;
+        published++;
+        wakeSender();
+    }
+
+    // Block until every published frame has been transmitted.
+    void flush() {
+        while (started && sent.load(std::memory_order_acquire) != published) waitForSender();
+    }
+
+    // Frames transmitted so far, and total time acquire() spent waiting.
+    uint32_t framesSent() const { return sent.load(std::memory_order_relaxed); }
+    uint32_t producerWaitMicros() const { return waitMicros; }
+
+private:
+    static const int8_t EMPTY = -1;
+
+    void begin() {
+        started = true;
+        #if defined(ESP32)
+        producerTask = xTaskGetCurrentTaskHandle();
+        xTaskCreatePinnedToCore(senderEntry, "led_show", 4096, this, SHOW_PIPELINE_PRIORITY,
+                                &senderTask, SHOW_PIPELINE_CORE);
+        #else
+        sender = std::thread(&ShowPipeline::senderLoop, this);
+        #endif
+    }
+
+    // The sender runs for the life of the program on the board; a host build
+    // drains and joins it at exit.
+    void end() {
+        #if !defined(ESP32)
+        if (!started) return;
+        flush();
+        stopping.store(true, std::memory_order_release);
+        wakeSender();
+        sender.join();
+        started = false;
+        #endif
+    }
+
+    void senderLoop() {
+        for (;;) {
+            int8_t index = slot.load(std::memory_order_acquire);
+            if (index == EMPTY) {
+                if (stopping.load(std::memory_order_acquire)) return;
+                sleepSender();
+                continue;
+            }
+            CRGB* frame = buffers[index];
+            slot.store(EMPTY, std::memory_order_release);
+            wakeProducer();
+
+            FastLED[0].setLeds(frame, NUM_LEDS);
+            FastLED.show();
+            sent.fetch_add(1, std::memory_order_release);
+            wakeProducer();
+        }
+    }
+
+    // Wake-ups: task notifications on the board (they latch, so a wake sent
+    // before the other side sleeps is not lost); the same latching flags
+    // under a mutex and condition variable on the host.
+    #if defined(ESP32)
+    static void senderEntry(void* self) { static_cast<ShowPipeline*>(self)->senderLoop(); }
+    void wakeSender() { xTaskNotifyGive(senderTask); }
+    void sleepSender() { ulTaskNotifyTake(pdTRUE, portMAX_DELAY); }
+    void wakeProducer() { xTaskNotifyGive(producerTask); }
+    void waitForSender() { ulTaskNotifyTake(pdTRUE, portMAX_DELAY); }
+
+    TaskHandle_t senderTask = nullptr;
+    TaskHandle_t producerTask = nullptr;
+    #else
+    void wakeSender() { notify(senderNote); }
+    void sleepSender() { take(senderNote); }
+    void wakeProducer() { notify(producerNote); }
+    void waitForSender() { take(producerNote); }
+
+    void notify(bool& note) {
+        {
+            std::lock_guard<std::mutex> lock(noteLock);
+            note = true;
+        }
+        noteCond.notify_all();
+    }
+    void take(bool& note) {
+        std::unique_lock<std::mutex> lock(noteLock);
+        noteCond.wait(lock, [&note] { return note; });
+        note = false;
+    }
+
+    std::thread sender;
+    std::mutex noteLock;
+    std::condition_variable noteCond;
+    bool senderNote = false;
+    bool producerNote = false;
+    #endif
+
+    CRGB buffers[2][NUM_LEDS];
+    std::atomic<int8_t> slot{EMPTY};
+    std::atomic<uint32_t> sent{0};
+    std::atomic<bool> stopping{false};
+    uint8_t back = 0;
+    uint32_t published = 0;
+    uint32_t waitMicros = 0;
+    bool started = false;
+};
+
+#endif // SHOW_PIPELINE_H
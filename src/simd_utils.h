@@ -21,50 +21,90 @@ public:
     }
 };
 
-// Optimized version of fadeToColorBy that processes multiple LEDs at once
-void simd_fade_to_color(CRGB* leds, int count, CRGB color, uint8_t fadeAmt) {
-    // Process LEDs in batches of 4 for better cache utilization
-    int i = 0;
-    
-    #if defined(ESP32)
-    // Process 4 LEDs at once to improve memory access patterns
-    for (; i < (count & ~0x3); i += 4) {
-        for (int j = 0; j < 4; j++) {
-            CRGB* led = &leds[i+j];
-            
-            // Red component with special handling
-            if (led->r < color.r) {
-                led->r = ((led->r << 8) + (((int)(((color.r - led->r) << 7) / rran) * fadeAmt / 255) << 1)) >> 8;
-            } else {
-                led->r = ((led->r << 8) + (((int)(((color.r - led->r) << 7) * rran) * fadeAmt / 255) << 1)) >> 8;
-            }
-            
-            // Green and blue components
-            led->g = ((led->g << 8) + ((((color.g - led->g) << 7) * fadeAmt / 255) << 1)) >> 8;
-            led->b = ((led->b << 8) + ((((color.b - led->b) << 7) * fadeAmt / 255) << 1)) >> 8;
-        }
+// ---------------------------------------------------------------------------
+// simd_fade_to_color: fade a run of LEDs toward `color` by fadeAmt/255.
+//
+// The look is defined by the original per-channel formula, kept below as
+// fade_pixel_reference(). Green and blue move toward the target by
+// (target - led) * fadeAmt / 255, with truncations that work out to
+//
+//   target >= led:  led + floor(|d| * fadeAmt / 255)
+//   target <  led:  led - floor((|d| * fadeAmt + 253) / 255)
+//
+// Red does the same with its step divided by rran when rising and
+// multiplied by rran when falling; the falling case can overshoot below zero
+// and wrap, which is part of the look and is reproduced exactly.
+//
+// The fast path is bit-identical to the reference and has no divisions:
+// /255 is a multiply-shift ((x + 1 + (x >> 8)) >> 8 for x < 65535, the high
+// word of x * ceil(2^32 / 255) for x < 2^24) and /rran uses a reciprocal
+// computed once per call.
+// ---------------------------------------------------------------------------
+
+// The original formula, one pixel. Kept as the definition of the fade and as
+// the fallback for rran values the fast path does not cover.
+inline void fade_pixel_reference(CRGB* led, CRGB color, uint8_t fadeAmt, int rr) {
+    // Red component with special handling
+    if (led->r < color.r) {
+        led->r = ((led->r << 8) + (((int)(((color.r - led->r) << 7) / rr) * fadeAmt / 255) << 1)) >> 8;
+    } else {
+        led->r = ((led->r << 8) + (((int)(((color.r - led->r) << 7) * rr) * fadeAmt / 255) << 1)) >> 8;
+    }
+
+    // Green and blue components
+    led->g = ((led->g << 8) + ((((color.g - led->g) << 7) * fadeAmt / 255) << 1)) >> 8;
+    led->b = ((led->b << 8) + ((((color.b - led->b) << 7) * fadeAmt / 255) << 1)) >> 8;
+}
+
+// floor(x / 255) for x < 65535.
+inline uint32_t fade_div255_small(uint32_t x) {
+    return (x + 1 + (x >> 8)) >> 8;
+}
+
+// floor(x / 255) for x < 2^24.
+inline uint32_t fade_div255(uint32_t x) {
+    return (uint32_t)(((uint64_t)x * 16843010u) >> 32); // ceil(2^32 / 255)
+}
+
+// Green/blue formula for a single channel value.
+inline uint8_t fade_channel(uint8_t led, uint8_t target, uint8_t fadeAmt) {
+    if (target >= led) return led + fade_div255_small((target - led) * fadeAmt);
+    return led - fade_div255_small((led - target) * fadeAmt + 253);
+}
+
+// Red formula for a single value. rranRecip is ceil(2^32 / rran) (unused
+// when rran == 1).
+inline uint8_t fade_red(uint8_t led, uint8_t target, uint8_t fadeAmt, int rr, uint32_t rranRecip) {
+    if (led < target) {
+        uint32_t step = (uint32_t)(target - led) << 7;
+        if (rr > 1) step = (uint32_t)(((uint64_t)step * rranRecip) >> 32);
+        return led + (fade_div255(step * fadeAmt) >> 7);
+    }
+    // Falling: may step past zero and wrap (matches the uint8_t store).
+    return (uint8_t)(led - fade_div255((uint32_t)(led - target) * rr * fadeAmt + 253));
+}
+
+// (inline: this header is included from more than one translation unit)
+inline void simd_fade_to_color(CRGB* leds, int count, CRGB color, uint8_t fadeAmt) {
+    const int rr = rran;
+
+    // The fast red path is exact for 1 <= rran <= 258.
+    if (rr < 1 || rr > 258) {
+        for (int i = 0; i < count; i++) fade_pixel_reference(&leds[i], color, fadeAmt, rr);
+        return;
     }
-    #endif
-    
-    // Handle remaining LEDs
-    for (; i < count; i++) {
+    const uint32_t rranRecip = rr > 1 ? (uint32_t)(0xFFFFFFFFu / (uint32_t)rr + 1) : 0;
+
+    for (int i = 0; i < count; i++) {
         CRGB* led = &leds[i];
-        
-        // Red component with special handling
-        if (led->r < color.r) {
-            led->r = ((led->r << 8) + (((int)(((color.r - led->r) << 7) / rran) * fadeAmt / 255) << 1)) >> 8;
-        } else {
-            led->r = ((led->r << 8) + (((int)(((color.r - led->r) << 7) * rran) * fadeAmt / 255) << 1)) >> 8;
-        }
-        
-        // Green and blue components
-        led->g = ((led->g << 8) + ((((color.g - led->g) << 7) * fadeAmt / 255) << 1)) >> 8;
-        led->b = ((led->b << 8) + ((((color.b - led->b) << 7) * fadeAmt / 255) << 1)) >> 8;
+        led->r = fade_red(led->r, color.r, fadeAmt, rr, rranRecip);
+        led->g = fade_channel(led->g, color.g, fadeAmt);
+        led->b = fade_channel(led->b, color.b, fadeAmt);
     }
 }
 
 // Initialize SIMD functionality
-bool init_simd() {
+inline bool init_simd() {
     return SimdOps::init();
 }
 
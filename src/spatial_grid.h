@@ -2,90 +2,161 @@
 #define SPATIAL_GRID_H
 
 #include <Arduino.h>
-#include <vector>
 #include "vec2.h"
 
-// A simpler implementation that avoids circular dependencies
-// This grid system stores pointers to void which will be cast to Boid*
-// This avoids including boid.h and creating circular dependencies
+// ---------------------------------------------------------------------------
+// SpatialGrid: uniform bucket grid for neighbor queries.
+//
+// The grid is rebuilt from scratch every frame with a counting sort into a
+// compressed (CSR) layout:
+//
+//   cellStart[c] .. cellStart[c + 1]   range of indices[] belonging to cell c
+//   indices[k]                         particle index (into the caller's arrays)
+//
+// Pass 1 counts particles per cell, a prefix sum turns counts into start
+// offsets, pass 2 scatters each particle index into its cell's range. There
+// are no per-cell containers and no per-cell cap, so every particle is always
+// findable no matter how densely the flock packs into one cell. The sort is
+// stable: within a cell, indices stay in ascending order.
+//
+// The grid knows nothing about what a particle is. rebuild() takes the count
+// and an accessor returning each particle's position, and neighbor queries
+// hand back indices, so it works for Boid arrays and BoidSwarm alike without
+// including either.
+// ---------------------------------------------------------------------------
 class SpatialGrid {
-private:
-    int gridWidth;
-    int gridHeight;
-    float cellWidth;
-    float cellHeight;
-    std::vector<void*>* grid;
-    int maxObjectsPerCell;
-
 public:
-    SpatialGrid(int width, int height, float worldWidth, float worldHeight, int maxObjects = 6) {
+    typedef uint16_t Index;
+
+    SpatialGrid(int width, int height, float worldWidth, float worldHeight, Index capacity = 255) {
         this->gridWidth = width;
         this->gridHeight = height;
         this->cellWidth = worldWidth / width;
         this->cellHeight = worldHeight / height;
-        this->maxObjectsPerCell = maxObjects;
-        
-        // Allocate the grid
-        grid = new std::vector<void*>[width * height];
-        
-        // Pre-allocate memory for each cell
-        for (int i = 0; i < width * height; i++) {
-            grid[i].reserve(maxObjects);
+
+        cellStart = new Index[width * height + 1];
+        for (int c = 0; c <= width * height; c++) {
+            cellStart[c] = 0;
         }
+        allocate(capacity);
     }
-    
+
     ~SpatialGrid() {
-        delete[] grid;
+        delete[] cellStart;
+        delete[] indices;
+        delete[] cellOf;
     }
-    
-    // Clear all cells in the grid
-    void clear() {
-        for (int i = 0; i < gridWidth * gridHeight; i++) {
-            grid[i].clear();
+
+    // Rebuild the grid from n particles. pos(i, x, y) must store particle i's
+    // position in x and y. Only allocates if n exceeds the current capacity.
+    template <typename PosFn>
+    void rebuild(Index n, PosFn pos) {
+        if (n > capacity) {
+            delete[] indices;
+            delete[] cellOf;
+            allocate(n);
         }
-    }
-    
-    // Add an object to the appropriate cell
-    void insert(void* object, float x, float y) {
-        int cellX = (int)(x / cellWidth);
-        int cellY = (int)(y / cellHeight);
-        
-        // Clamp to grid boundaries
-        cellX = constrain(cellX, 0, gridWidth - 1);
-        cellY = constrain(cellY, 0, gridHeight - 1);
-        
-        // Add to the appropriate cell
-        int cellIndex = cellY * gridWidth + cellX;
-        if (grid[cellIndex].size() < maxObjectsPerCell) {
-            grid[cellIndex].push_back(object);
+        count = n;
+
+        const int cells = gridWidth * gridHeight;
+        for (int c = 0; c <= cells; c++) {
+            cellStart[c] = 0;
+        }
+
+        // Pass 1: bin each particle and count per cell (counts land one slot
+        // to the right so the prefix sum below yields start offsets directly).
+        for (Index i = 0; i < n; i++) {
+            float x, y;
+            pos(i, x, y);
+            Index cell = cellIndex(x, y);
+            cellOf[i] = cell;
+            cellStart[cell + 1]++;
+        }
+
+        for (int c = 0; c < cells; c++) {
+            cellStart[c + 1] += cellStart[c];
+        }
+
+        // Pass 2: scatter indices. cellStart[c] is used as the write cursor for
+        // cell c and ends up at the old cellStart[c + 1]; shift back afterwards.
+        for (Index i = 0; i < n; i++) {
+            indices[cellStart[cellOf[i]]++] = i;
         }
+        for (int c = cells; c > 0; c--) {
+            cellStart[c] = cellStart[c - 1];
+        }
+        cellStart[0] = 0;
     }
-    
-    // Get all objects within a certain radius of a point
-    std::vector<void*> getNeighbors(float x, float y, float radius) {
-        std::vector<void*> neighbors;
-        neighbors.reserve(maxObjectsPerCell * 9); // Worst case: 9 cells, all full
-        
+
+    // Visit every particle stored in the cells overlapping the square of
+    // half-size `radius` around (x, y), calling fn(Index i) for each.
+    // Particles are visited in the same order every time (cells row by row,
+    // then ascending index within a cell). Nothing is allocated, so this is
+    // safe to call per boid per frame.
+    template <typename Fn>
+    void forEachNeighbor(float x, float y, float radius, Fn fn) const {
         // Calculate the cell range to check
         int minCellX = max(0, (int)((x - radius) / cellWidth));
         int maxCellX = min(gridWidth - 1, (int)((x + radius) / cellWidth));
         int minCellY = max(0, (int)((y - radius) / cellHeight));
         int maxCellY = min(gridHeight - 1, (int)((y + radius) / cellHeight));
-        
-        // Check all cells in the range
+        // A window entirely off one side of the grid leaves min > max. Bail out
+        // so the row runs below only ever index cells inside the grid.
+        if (minCellX > maxCellX || minCellY > maxCellY) return;
+
         for (int cellY = minCellY; cellY <= maxCellY; cellY++) {
-            for (int cellX = minCellX; cellX <= maxCellX; cellX++) {
-                int cellIndex = cellY * gridWidth + cellX;
-                
-                // Add all objects from this cell
-                for (void* obj : grid[cellIndex]) {
-                    neighbors.push_back(obj);
-                }
+            // Cells of one row are contiguous in indices[], so a row of the
+            // query window is a single run.
+            Index begin = cellStart[cellY * gridWidth + minCellX];
+            Index end = cellStart[cellY * gridWidth + maxCellX + 1];
+            for (Index k = begin; k < end; k++) {
+                fn(indices[k]);
             }
         }
-        
-        return neighbors;
     }
+
+    // Span form of the same query: copies up to `maxOut` neighbor indices into
+    // the caller's scratch buffer and returns how many were found in total
+    // (which may exceed maxOut; only the first maxOut are written).
+    size_t getNeighbors(float x, float y, float radius, Index* out, size_t maxOut) const {
+        size_t found = 0;
+        forEachNeighbor(x, y, radius, [&](Index i) {
+            if (found < maxOut) out[found] = i;
+            found++;
+        });
+        return found;
+    }
+
+    // Number of particles indexed by the last rebuild().
+    Index size() const { return count; }
+
+private:
+    void allocate(Index n) {
+        capacity = n;
+        indices = new Index[n ? n : 1];
+        cellOf = new Index[n ? n : 1];
+    }
+
+    Index cellIndex(float x, float y) const {
+        int cellX = (int)(x / cellWidth);
+        int cellY = (int)(y / cellHeight);
+
+        // Clamp to grid boundaries
+        cellX = constrain(cellX, 0, gridWidth - 1);
+        cellY = constrain(cellY, 0, gridHeight - 1);
+        return (Index)(cellY * gridWidth + cellX);
+    }
+
+    int gridWidth;
+    int gridHeight;
+    float cellWidth;
+    float cellHeight;
+
+    Index* cellStart = nullptr; // gridWidth * gridHeight + 1 entries
+    Index* indices = nullptr;   // particle indices grouped by cell
+    Index* cellOf = nullptr;    // scratch: cell of each particle during rebuild
+    Index capacity = 0;
+    Index count = 0;
 };
 
 #endif // SPATIAL_GRID_H
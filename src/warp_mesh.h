@@ -0,0 +1,153 @@
+#ifndef WARP_MESH_H
+#define WARP_MESH_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include <math.h>
+
+// Control points per side of the feedback warp mesh. SIZE - 1 must divide
+// the feedback width and height: 9 gives 6x6-pixel cells over 48x48.
+#ifndef FEEDBACK_MESH_SIZE
+#define FEEDBACK_MESH_SIZE 9
+#endif
+
+enum FeedbackMesh : uint8_t {
+    MESH_OFF = 0,  // global affine transform only
+    MESH_RIPPLE,   // radial sine waves running outward from the center
+    MESH_SWIRL,    // twist strongest at mid radius, slowly reversing
+    MESH_BULGE,    // breathing magnification around the center
+    MESH_COUNT
+};
+
+// ---------------------------------------------------------------------------
+// WarpMesh: Milkdrop-style per-vertex warp for VideoFeedback.
+//
+// A SIZE x SIZE grid of control points spans the WIDTH x HEIGHT image. Every
+// frame evaluate() places each vertex's source position: the global affine
+// transform of the feedback pass plus a displacement from the selected mesh
+// equation. row() then interpolates the vertices bilinearly into one source
+// position per destination pixel.
+//
+// Everything per frame is integer: the equations use sin16() on a per-vertex
+// radius and unit vector (Q16 / Q15) computed once in the constructor, and
+// displace along the radius and its tangent in 16.16 fixed point. row()
+// interpolates each vertex column down to the row, then steps across each
+// cell with one add per pixel - no float math per pixel or per vertex.
+// ---------------------------------------------------------------------------
+template <uint8_t WIDTH, uint8_t HEIGHT, uint8_t SIZE>
+class WarpMesh {
+public:
+    static const uint8_t CELL_W = WIDTH / (SIZE - 1);
+    static const uint8_t CELL_H = HEIGHT / (SIZE - 1);
+    static_assert(CELL_W * (SIZE - 1) == WIDTH && CELL_H * (SIZE - 1) == HEIGHT,
+                  "mesh cells must tile the image");
+
+    FeedbackMesh mode = MESH_OFF;
+    uint8_t amount = 255;  // 0-255 scale on the displacement
+
+    WarpMesh() {
+        const float cx = WIDTH * 0.5f, cy = HEIGHT * 0.5f;
+        const float maxRad = sqrtf(cx * cx + cy * cy);
+        for (uint8_t gy = 0; gy < SIZE; gy++) {
+            for (uint8_t gx = 0; gx < SIZE; gx++) {
+                const float dx = gx * CELL_W - cx, dy = gy * CELL_H - cy;
+                const float r = sqrtf(dx * dx + dy * dy);
+                const uint16_t i = gy * SIZE + gx;
+                rad[i] = (uint16_t)min(r / maxRad * 65535.0f, 65535.0f);
+                ux[i] = r > 0 ? (int16_t)lrintf(dx / r * 32767.0f) : 0;
+                uy[i] = r > 0 ? (int16_t)lrintf(dy / r * 32767.0f) : 0;
+            }
+        }
+    }
+
+    bool enabled() const { return mode != MESH_OFF; }
+
+    const char* name() const {
+        static const char* const names[MESH_COUNT] = {"OFF", "RIPPLE", "SWIRL", "BULGE"};
+        return names[mode];
+    }
+
+    // Place every vertex: the 16.16 affine transform (source of pixel (0,0)
+    // and the steps per column / row) plus this frame's displacement.
+    void evaluate(int32_t sx00, int32_t sy00, int32_t dxCol, int32_t dyCol,
+                  int32_t dxRow, int32_t dyRow, uint32_t timeMs) {
+        const uint16_t wave = (uint16_t)(timeMs * 40);   // ~1.6 s period
+        const uint16_t breathe = (uint16_t)(timeMs * 20); // ~3.3 s
+        const uint16_t turn = (uint16_t)(timeMs * 10);    // ~6.6 s
+        const int32_t amp = (int32_t)amount << 1;         // 510 at full: 128 * amp ~ 1 px
+
+        for (uint8_t gy = 0; gy < SIZE; gy++) {
+            for (uint8_t gx = 0; gx < SIZE; gx++) {
+                const uint16_t i = gy * SIZE + gx;
+                const int32_t px = gx * CELL_W, py = gy * CELL_H;
+
+                // Radial and tangential displacement, 16.16.
+                int32_t radial = 0, tangent = 0;
+                switch (mode) {
+                    case MESH_RIPPLE:
+                        // ~0.75 px, three wavelengths from center to corner.
+                        radial = scaleQ15(96 * amp, sin16((uint16_t)(rad[i] * 3) - wave));
+                        break;
+                    case MESH_SWIRL:
+                        // ~1.5 px at mid radius, direction turning every ~3 s.
+                        tangent = scaleQ15(scaleQ15(192 * amp, sin16(rad[i] >> 1)), sin16(turn));
+                        break;
+                    case MESH_BULGE:
+                        // Up to ~1 px toward the center, breathing.
+                        radial = -scaleQ15(scaleQ15(128 * amp, sin16(rad[i] >> 1)),
+                                           (32768 + sin16(breathe)) >> 1);
+                        break;
+                    default:
+                        break;
+                }
+
+                vx[i] = sx00 + px * dxCol + py * dxRow +
+                        scaleQ15(radial, ux[i]) - scaleQ15(tangent, uy[i]);
+                vy[i] = sy00 + px * dyCol + py * dyRow +
+                        scaleQ15(radial, uy[i]) + scaleQ15(tangent, ux[i]);
+            }
+        }
+    }
+
+    // 16.16 source positions of destination row y into xs[WIDTH], ys[WIDTH].
+    void row(uint8_t y, int32_t* xs, int32_t* ys) const {
+        const uint8_t gy = y / CELL_H, j = y % CELL_H;
+        const int32_t* topX = vx + gy * SIZE;
+        const int32_t* topY = vy + gy * SIZE;
+
+        // Every vertex column interpolated down to this row.
+        int32_t colX[SIZE], colY[SIZE];
+        for (uint8_t gx = 0; gx < SIZE; gx++) {
+            colX[gx] = topX[gx] + (topX[gx + SIZE] - topX[gx]) * j / CELL_H;
+            colY[gx] = topY[gx] + (topY[gx + SIZE] - topY[gx]) * j / CELL_H;
+        }
+
+        for (uint8_t gx = 0; gx < SIZE - 1; gx++) {
+            const int32_t stepX = (colX[gx + 1] - colX[gx]) / CELL_W;
+            const int32_t stepY = (colY[gx + 1] - colY[gx]) / CELL_W;
+            int32_t sx = colX[gx], sy = colY[gx];
+            for (uint8_t i = 0; i < CELL_W; i++, sx += stepX, sy += stepY) {
+                xs[gx * CELL_W + i] = sx;
+                ys[gx * CELL_W + i] = sy;
+            }
+        }
+    }
+
+private:
+    // v * q / 32768 for a Q15 factor q.
+    static int32_t scaleQ15(int32_t v, int32_t q) {
+        return (int32_t)(((int64_t)v * q) >> 15);
+    }
+
+    // Per vertex: distance from the image center (Q16, 65535 = corner) and
+    // the unit vector pointing away from it (Q15).
+    uint16_t rad[SIZE * SIZE];
+    int16_t ux[SIZE * SIZE];
+    int16_t uy[SIZE * SIZE];
+
+    // This frame's vertex source positions, 16.16.
+    int32_t vx[SIZE * SIZE];
+    int32_t vy[SIZE * SIZE];
+};
+
+#endif // WARP_MESH_H
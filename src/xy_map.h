@@ -0,0 +1,82 @@
+#ifndef XY_MAP_H
+#define XY_MAP_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// ---------------------------------------------------------------------------
+// Compile-time XY mapping.
+//
+// The strip index of every display pixel is computed by the compiler from the
+// config.h geometry (ROWS, COLS, kMatrixLayout, panel size and flips) into
+// kXYTable, so matrixXY() is a single table load and lookups with constant
+// coordinates fold away entirely.
+//
+// xyLayoutIndex() is the generator for one layout and is usable on its own
+// (e.g. to build a table for a different panel). Flips are applied before the
+// layout, matching the original hand-written matrixXY().
+// ---------------------------------------------------------------------------
+
+// Strip index of (x, y) on a w x h display wired as `layout`, no flips.
+constexpr uint16_t xyLayoutIndex(MatrixLayout layout, uint8_t w, uint8_t h, uint8_t x, uint8_t y) {
+    switch (layout) {
+        case LAYOUT_PROGRESSIVE:
+            return y * w + x;
+        case LAYOUT_SERPENTINE:
+            return (y & 0x01) ? y * w + (w - 1 - x) : y * w + x;
+        case LAYOUT_COLUMN_MAJOR:
+            return x * h + y;
+        case LAYOUT_COLUMN_SERPENTINE:
+            return (x & 0x01) ? x * h + (h - 1 - y) : x * h + y;
+        case LAYOUT_TILED: {
+            const uint8_t panelsX = w / kPanelWidth;
+            const uint16_t panel = (y / kPanelHeight) * panelsX + (x / kPanelWidth);
+            const uint8_t lx = x % kPanelWidth;
+            const uint8_t ly = y % kPanelHeight;
+            const uint16_t local = (kPanelSerpentine && (ly & 0x01))
+                                       ? ly * kPanelWidth + (kPanelWidth - 1 - lx)
+                                       : ly * kPanelWidth + lx;
+            return panel * (kPanelWidth * kPanelHeight) + local;
+        }
+    }
+    return 0;
+}
+
+// Strip index of display pixel (x, y) for this build's matrix.
+constexpr uint16_t xyMapIndex(uint8_t x, uint8_t y) {
+    if (kMatrixFlipV) y = (ROWS - 1) - y;
+    if (kMatrixFlipH) x = (COLS - 1) - x;
+    return xyLayoutIndex(kMatrixLayout, COLS, ROWS, x, y);
+}
+
+static_assert(kMatrixLayout != LAYOUT_TILED || (COLS % kPanelWidth == 0 && ROWS % kPanelHeight == 0),
+              "tiled layout: panel size must divide the matrix size");
+
+struct XYTable {
+    uint16_t index[ROWS][COLS];
+    // +1 / -1 when display row y is a contiguous forward / backward run of the
+    // strip, 0 when it is not (column-major and multi-panel layouts).
+    int8_t rowStep[ROWS];
+};
+
+constexpr XYTable buildXYTable() {
+    XYTable t{};
+    for (uint8_t y = 0; y < ROWS; y++) {
+        for (uint8_t x = 0; x < COLS; x++) {
+            t.index[y][x] = xyMapIndex(x, y);
+        }
+
+        int step = COLS > 1 ? (int)t.index[y][1] - (int)t.index[y][0] : 1;
+        if (step != 1 && step != -1) step = 0;
+        for (uint8_t x = 1; x < COLS && step != 0; x++) {
+            if ((int)t.index[y][x] - (int)t.index[y][x - 1] != step) step = 0;
+        }
+        t.rowStep[y] = (int8_t)step;
+    }
+    return t;
+}
+
+// One copy shared by every translation unit (C++17 inline variable).
+inline constexpr XYTable kXYTable = buildXYTable();
+
+#endif // XY_MAP_H